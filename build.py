@@ -231,6 +231,8 @@ CTX.INPUT['common'] = """
  SerializableEEException.cpp
  SQLException.cpp
  InterruptException.cpp
+ LZ4Codec.cpp
+ MemoryPolicy.cpp
  StringRef.cpp
  tabletuple.cpp
  TupleSchema.cpp
@@ -244,6 +246,7 @@ CTX.INPUT['common'] = """
  executorcontext.cpp
  serializeio.cpp
  StreamPredicateList.cpp
+ subquerycontext.cpp
  Topend.cpp
  TupleOutputStream.cpp
  TupleOutputStreamProcessor.cpp
@@ -356,6 +359,7 @@ CTX.INPUT['storage'] = """
  ElasticScanner.cpp
  ExportTupleStream.cpp
  MaterializedViewHandler.cpp
+ MaterializedViewMinMaxTracker.cpp
  MaterializedViewTriggerForInsert.cpp
  MaterializedViewTriggerForWrite.cpp
  persistenttable.cpp
@@ -454,9 +458,12 @@ if whichtests in ("${eetestsuite}", "common"):
     CTX.TESTS['common'] = """
      debuglog_test
      elastic_hashinator_test
+     lz4codec_test
+     MemoryPolicyTest
      nvalue_test
      pool_test
      serializeio_test
+     subquerycontext_test
      tabletuple_test
      ThreadLocalPoolTest
      tupleschema_test
@@ -476,6 +483,8 @@ if whichtests in ("${eetestsuite}", "executors"):
     OptimizedProjectorTest
     MergeReceiveExecutorTest
     PartitionByExecutorTest
+    PipelinedExecutionTest
+    SemiJoinFilterTest
     TestGeneratedPlans
     """
 
@@ -503,6 +512,7 @@ if whichtests in ("${eetestsuite}", "storage"):
      DRBinaryLog_test
      DRTupleStream_test
      ExportTupleStream_test
+     MaterializedViewMinMaxTrackerTest
      PersistentTableMemStatsTest
      StreamedTable_test
      TempTableLimitsTest
@@ -519,6 +529,7 @@ if whichtests in ("${eetestsuite}", "storage"):
 
 if whichtests in ("${eetestsuite}", "structures"):
     CTX.TESTS['structures'] = """
+     BlockedBloomFilterTest
      CompactingMapTest
      CompactingMapIndexCountTest
      CompactingHashTest
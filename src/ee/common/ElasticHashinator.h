@@ -105,25 +105,27 @@ protected:
         return partitionForToken(hashCode);
     }
 
+    /*
+     * The top bits of the hash pick a slice of the ring. Most slices lie
+     * within a single token's range and need no search at all; the rest
+     * search only the few tokens that start inside them.
+     */
     int32_t partitionForToken(int32_t hashCode) const {
-        int32_t min = 0;
-        int32_t max = tokenCount - 1;
+        const uint32_t bucket = (static_cast<uint32_t>(hashCode) ^ 0x80000000u) >> bucketShift;
+        uint32_t found = bucketTokens[bucket];
+        uint32_t min = found + 1;
+        uint32_t max = bucketTokens[bucket + 1];
 
         while (min <= max) {
-            assert(min >= 0);
-            assert(max >= 0);
             uint32_t mid = (min + max) >> 1;
-            int32_t midval = tokens[mid * 2];
-
-            if (midval < hashCode) {
+            if (tokens[mid * 2] <= hashCode) {
+                found = mid;
                 min = mid + 1;
-            } else if (midval > hashCode) {
-                max = mid - 1;
             } else {
-                return tokens[mid * 2 + 1];
+                max = mid - 1;
             }
         }
-        return tokens[(min - 1) * 2 + 1];
+        return tokens[found * 2 + 1];
     }
 
     std::string debug() const {
@@ -141,11 +143,43 @@ protected:
 
 private:
 
-    ElasticHashinator(int32_t *tokens, uint32_t tokenCount, bool owned) : tokens(tokens), tokenCount(tokenCount), tokensOwner( owned ? tokens : NULL ) {}
+    ElasticHashinator(int32_t *tokens, uint32_t tokenCount, bool owned) : tokens(tokens), tokenCount(tokenCount), tokensOwner( owned ? tokens : NULL ) {
+        initBuckets();
+    }
+
+    /*
+     * Record, for each of the 2^bits slices of the ring, the token whose range
+     * covers the start of the slice. Two slices per token keeps most slices
+     * free of token boundaries.
+     */
+    void initBuckets() {
+        assert(tokenCount > 0);
+        uint32_t bits = 1;
+        while (bits < MAX_BUCKET_BITS && (1u << bits) < tokenCount * 2) {
+            bits++;
+        }
+        bucketShift = 32 - bits;
+        const uint32_t bucketCount = 1u << bits;
+        bucketTokens.reset(new uint32_t[bucketCount + 1]);
+
+        uint32_t token = 0;
+        for (uint32_t bucket = 0; bucket < bucketCount; bucket++) {
+            const int32_t bucketStart = static_cast<int32_t>((bucket << bucketShift) ^ 0x80000000u);
+            while (token + 1 < tokenCount && tokens[(token + 1) * 2] <= bucketStart) {
+                token++;
+            }
+            bucketTokens[bucket] = token;
+        }
+        bucketTokens[bucketCount] = tokenCount - 1;
+    }
+
+    static const uint32_t MAX_BUCKET_BITS = 16;
 
     const int32_t *tokens;
     const uint32_t tokenCount;
     boost::scoped_array<int32_t> tokensOwner;
+    boost::scoped_array<uint32_t> bucketTokens;
+    uint32_t bucketShift;
 
 };
 }
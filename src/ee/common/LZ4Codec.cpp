@@ -0,0 +1,211 @@
+/* This file is part of VoltDB.
+ * Copyright (C) 2008-2016 VoltDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with VoltDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "common/LZ4Codec.h"
+
+#include <cstring>
+
+using namespace voltdb;
+
+namespace {
+
+// Constants of the LZ4 block format
+const size_t MIN_MATCH = 4;
+// The last 5 bytes of a block are always literals
+const size_t LAST_LITERALS = 5;
+// and the last match must start at least 12 bytes before the end.
+const size_t MF_LIMIT = 12;
+const size_t MAX_DISTANCE = 65535;
+const size_t RUN_MASK = 15;
+
+const int HASH_LOG = 12;
+
+inline uint32_t read32(const char *p) {
+    uint32_t value;
+    ::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint32_t hashSequence(uint32_t sequence) {
+    return (sequence * 2654435761U) >> (32 - HASH_LOG);
+}
+
+// Lengths that do not fit in the 4 bits of the token continue
+// as a run of 255s and a final byte.
+bool writeLengthTail(size_t length, char *&op, const char *opEnd) {
+    while (length >= 255) {
+        if (op >= opEnd) {
+            return false;
+        }
+        *op++ = static_cast<char>(255);
+        length -= 255;
+    }
+    if (op >= opEnd) {
+        return false;
+    }
+    *op++ = static_cast<char>(length);
+    return true;
+}
+
+bool readLengthTail(const uint8_t *&ip, const uint8_t *ipEnd, size_t &length) {
+    uint8_t next;
+    do {
+        if (ip >= ipEnd) {
+            return false;
+        }
+        next = *ip++;
+        length += next;
+    } while (next == 255);
+    return true;
+}
+
+// A matchLength of 0 writes the final, literals-only sequence.
+bool writeSequence(const char *literals, size_t literalLength,
+                   size_t offset, size_t matchLength,
+                   char *&op, const char *opEnd) {
+    size_t literalCode = literalLength < RUN_MASK ? literalLength : RUN_MASK;
+    size_t matchCode = (matchLength == 0) ? 0 : matchLength - MIN_MATCH;
+    size_t matchToken = matchCode < RUN_MASK ? matchCode : RUN_MASK;
+    if (op >= opEnd) {
+        return false;
+    }
+    *op++ = static_cast<char>((literalCode << 4) | matchToken);
+    if (literalCode == RUN_MASK && !writeLengthTail(literalLength - RUN_MASK, op, opEnd)) {
+        return false;
+    }
+    if (static_cast<size_t>(opEnd - op) < literalLength) {
+        return false;
+    }
+    ::memcpy(op, literals, literalLength);
+    op += literalLength;
+    if (matchLength == 0) {
+        return true;
+    }
+    if (opEnd - op < 2) {
+        return false;
+    }
+    *op++ = static_cast<char>(offset & 0xff);
+    *op++ = static_cast<char>(offset >> 8);
+    if (matchToken == RUN_MASK && !writeLengthTail(matchCode - RUN_MASK, op, opEnd)) {
+        return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+size_t LZ4Codec::compress(const char *src, size_t srcLength, char *dst, size_t dstCapacity) {
+    char *op = dst;
+    const char *opEnd = dst + dstCapacity;
+    size_t anchor = 0;
+
+    if (srcLength > MF_LIMIT) {
+        int32_t table[1 << HASH_LOG];
+        for (int i = 0; i < (1 << HASH_LOG); ++i) {
+            table[i] = -1;
+        }
+        const size_t matchLimit = srcLength - LAST_LITERALS;
+        const size_t lastMatchStart = srcLength - MF_LIMIT;
+        size_t ip = 0;
+        while (ip < lastMatchStart) {
+            uint32_t sequence = read32(src + ip);
+            uint32_t hash = hashSequence(sequence);
+            int32_t candidate = table[hash];
+            table[hash] = static_cast<int32_t>(ip);
+            if (candidate < 0 || ip - candidate > MAX_DISTANCE ||
+                read32(src + candidate) != sequence) {
+                ++ip;
+                continue;
+            }
+
+            // grow the match backwards over pending literals, then forwards
+            size_t matchStart = ip;
+            size_t refStart = candidate;
+            while (matchStart > anchor && refStart > 0 && src[matchStart - 1] == src[refStart - 1]) {
+                --matchStart;
+                --refStart;
+            }
+            size_t matchEnd = ip + MIN_MATCH;
+            size_t refEnd = candidate + MIN_MATCH;
+            while (matchEnd < matchLimit && src[matchEnd] == src[refEnd]) {
+                ++matchEnd;
+                ++refEnd;
+            }
+
+            if ( ! writeSequence(src + anchor, matchStart - anchor,
+                                 matchStart - refStart, matchEnd - matchStart, op, opEnd)) {
+                return 0;
+            }
+            ip = matchEnd;
+            anchor = ip;
+        }
+    }
+
+    if ( ! writeSequence(src + anchor, srcLength - anchor, 0, 0, op, opEnd)) {
+        return 0;
+    }
+    return static_cast<size_t>(op - dst);
+}
+
+bool LZ4Codec::decompress(const char *src, size_t srcLength, char *dst, size_t dstLength) {
+    const uint8_t *ip = reinterpret_cast<const uint8_t*>(src);
+    const uint8_t *ipEnd = ip + srcLength;
+    char *op = dst;
+    const char *opEnd = dst + dstLength;
+
+    while (ip < ipEnd) {
+        const uint8_t token = *ip++;
+        size_t literalLength = token >> 4;
+        if (literalLength == RUN_MASK && !readLengthTail(ip, ipEnd, literalLength)) {
+            return false;
+        }
+        if (static_cast<size_t>(ipEnd - ip) < literalLength ||
+            static_cast<size_t>(opEnd - op) < literalLength) {
+            return false;
+        }
+        ::memcpy(op, ip, literalLength);
+        ip += literalLength;
+        op += literalLength;
+        if (ip == ipEnd) {
+            // the last sequence has no match part
+            break;
+        }
+
+        if (ipEnd - ip < 2) {
+            return false;
+        }
+        size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<size_t>(op - dst)) {
+            return false;
+        }
+        size_t matchLength = token & RUN_MASK;
+        if (matchLength == RUN_MASK && !readLengthTail(ip, ipEnd, matchLength)) {
+            return false;
+        }
+        matchLength += MIN_MATCH;
+        if (static_cast<size_t>(opEnd - op) < matchLength) {
+            return false;
+        }
+        // the match may overlap the bytes being written, so copy forwards
+        const char *match = op - offset;
+        for (size_t i = 0; i < matchLength; ++i) {
+            op[i] = match[i];
+        }
+        op += matchLength;
+    }
+    return op == opEnd;
+}
@@ -0,0 +1,61 @@
+/* This file is part of VoltDB.
+ * Copyright (C) 2008-2016 VoltDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with VoltDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LZ4CODEC_H_
+#define LZ4CODEC_H_
+
+#include <cstddef>
+#include <stdint.h>
+
+namespace voltdb
+{
+
+/**
+ * Compressor and decompressor for the LZ4 block format, so that buffers
+ * produced here can be read with the lz4 library on the Java side.
+ * The compressor favors speed over ratio: it does a single greedy pass
+ * with a small hash table of recent 4-byte sequences.
+ */
+class LZ4Codec
+{
+
+  public:
+
+    /**
+     * Worst case size of the compressed form of srcLength bytes.
+     */
+    static size_t maxCompressedLength(size_t srcLength) {
+        return srcLength + (srcLength / 255) + 16;
+    }
+
+    /**
+     * Compress srcLength bytes from src into dst. Returns the compressed
+     * length, or 0 if the result does not fit in dstCapacity bytes.
+     */
+    static size_t compress(const char *src, size_t srcLength, char *dst, size_t dstCapacity);
+
+    /**
+     * Decompress srcLength bytes from src into dst, which must hold exactly
+     * dstLength bytes once decompressed. Returns false if the input is
+     * malformed or does not decompress to dstLength bytes.
+     */
+    static bool decompress(const char *src, size_t srcLength, char *dst, size_t dstLength);
+};
+
+} // namespace voltdb
+
+#endif // LZ4CODEC_H_
@@ -0,0 +1,211 @@
+/* This file is part of VoltDB.
+ * Copyright (C) 2008-2016 VoltDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with VoltDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/MemoryPolicy.h"
+
+#include "common/FatalException.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#ifdef LINUX
+#include <sys/syscall.h>
+#endif
+
+namespace voltdb {
+
+const std::size_t MemoryPolicy::HUGE_PAGE_SIZE;
+
+struct MemoryPolicySettings {
+    MemoryPolicy::HugePages m_hugePages;
+    bool m_localNode;
+};
+
+static MemoryPolicySettings settingsFromEnvironment()
+{
+    MemoryPolicySettings settings;
+    settings.m_hugePages = MemoryPolicy::HUGE_PAGES_TRANSPARENT;
+    settings.m_localNode = false;
+    const char* hugePages = ::getenv("VOLTDB_EE_HUGE_PAGES");
+    if (hugePages != NULL) {
+        if (::strcmp(hugePages, "none") == 0) {
+            settings.m_hugePages = MemoryPolicy::HUGE_PAGES_NONE;
+        }
+        else if (::strcmp(hugePages, "explicit") == 0) {
+            settings.m_hugePages = MemoryPolicy::HUGE_PAGES_EXPLICIT;
+        }
+    }
+    const char* localNode = ::getenv("VOLTDB_EE_NUMA_LOCAL");
+    if (localNode != NULL) {
+        settings.m_localNode = (::strcmp(localNode, "true") == 0 || ::strcmp(localNode, "1") == 0);
+    }
+    return settings;
+}
+
+static MemoryPolicySettings& getSettings()
+{
+    static MemoryPolicySettings settings = settingsFromEnvironment();
+    return settings;
+}
+
+void MemoryPolicy::configure(HugePages hugePages, bool localNode)
+{
+    getSettings().m_hugePages = hugePages;
+    getSettings().m_localNode = localNode;
+}
+
+MemoryPolicy::HugePages MemoryPolicy::hugePages()
+{
+    return getSettings().m_hugePages;
+}
+
+bool MemoryPolicy::localNode()
+{
+    return getSettings().m_localNode;
+}
+
+static std::size_t roundUp(std::size_t size, std::size_t unit)
+{
+    return (size + unit - 1) / unit * unit;
+}
+
+std::size_t MemoryPolicy::mappedSize(std::size_t size)
+{
+#ifdef MEMCHECK
+    return size;
+#else
+    // Rounding up a block that is within an eighth of a whole number of
+    // huge pages costs only untouched address space, not resident memory.
+    std::size_t hugeSize = roundUp(size, HUGE_PAGE_SIZE);
+    if (size > 0 && hugeSize - size <= HUGE_PAGE_SIZE / 8) {
+        return hugeSize;
+    }
+    static const std::size_t pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return roundUp(size, pageSize);
+#endif
+}
+
+#ifndef MEMCHECK
+
+static void* mapAnonymous(std::size_t length, int flags)
+{
+    void* block = ::mmap(0, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON | flags, -1, 0);
+    return (block == MAP_FAILED) ? NULL : block;
+}
+
+/**
+ * Map length bytes at a huge page boundary by mapping an extra huge
+ * page and trimming both ends.
+ */
+static void* mapHugeAligned(std::size_t length)
+{
+    char* mapping = static_cast<char*>(mapAnonymous(length + MemoryPolicy::HUGE_PAGE_SIZE, 0));
+    if (mapping == NULL) {
+        return NULL;
+    }
+    char* block = reinterpret_cast<char*>(roundUp(reinterpret_cast<uintptr_t>(mapping),
+                                                  MemoryPolicy::HUGE_PAGE_SIZE));
+    std::size_t head = block - mapping;
+    if (head > 0) {
+        ::munmap(mapping, head);
+    }
+    std::size_t tail = MemoryPolicy::HUGE_PAGE_SIZE - head;
+    if (tail > 0) {
+        ::munmap(block + length, tail);
+    }
+#if defined(LINUX) && defined(MADV_HUGEPAGE)
+    (void)::madvise(block, length, MADV_HUGEPAGE);
+#endif
+    return block;
+}
+
+/**
+ * Ask the kernel to place the pages of a block, which are not touched
+ * yet, on the NUMA node of the CPU this thread is running on. This is
+ * a preference rather than a strict binding, so that a partition whose
+ * node is full spills over to another one instead of failing.
+ */
+static void placeOnLocalNode(void* block, std::size_t length)
+{
+#if defined(LINUX) && defined(SYS_getcpu) && defined(SYS_mbind)
+    static const int MPOL_PREFERRED_MODE = 1;
+    static const unsigned int BITS_PER_WORD = sizeof(unsigned long) * 8;
+    static const unsigned int NODE_MASK_WORDS = 16;
+    unsigned int cpu;
+    unsigned int node;
+    if (::syscall(SYS_getcpu, &cpu, &node, NULL) != 0 || node >= NODE_MASK_WORDS * BITS_PER_WORD) {
+        return;
+    }
+    unsigned long nodeMask[NODE_MASK_WORDS];
+    ::memset(nodeMask, 0, sizeof(nodeMask));
+    nodeMask[node / BITS_PER_WORD] = 1UL << (node % BITS_PER_WORD);
+    (void)::syscall(SYS_mbind, block, length, MPOL_PREFERRED_MODE, nodeMask,
+                    static_cast<unsigned long>(NODE_MASK_WORDS * BITS_PER_WORD), 0);
+#endif
+}
+
+#endif
+
+void* MemoryPolicy::allocateBlock(std::size_t size)
+{
+#ifdef MEMCHECK
+    return new char[size];
+#else
+    const MemoryPolicySettings& settings = getSettings();
+    std::size_t length = mappedSize(size);
+    void* block = NULL;
+    if (settings.m_hugePages != HUGE_PAGES_NONE && length >= HUGE_PAGE_SIZE) {
+#if defined(LINUX) && defined(MAP_HUGETLB)
+        if (settings.m_hugePages == HUGE_PAGES_EXPLICIT && length % HUGE_PAGE_SIZE == 0) {
+            block = mapAnonymous(length, MAP_HUGETLB);
+        }
+#endif
+        if (block == NULL) {
+            block = mapHugeAligned(length);
+        }
+    }
+    else {
+        block = mapAnonymous(length, 0);
+    }
+    if (block == NULL) {
+        throwFatalException("Failed to map a %ld byte block: %s",
+                            static_cast<long>(length), ::strerror(errno));
+    }
+    if (settings.m_localNode) {
+        placeOnLocalNode(block, length);
+    }
+    return block;
+#endif
+}
+
+void MemoryPolicy::freeBlock(void* block, std::size_t size)
+{
+#ifdef MEMCHECK
+    delete [] static_cast<char*>(block);
+#else
+    if (block != NULL && ::munmap(block, mappedSize(size)) != 0) {
+        throwFatalException("Failed to unmap a %ld byte block: %s",
+                            static_cast<long>(size), ::strerror(errno));
+    }
+#endif
+}
+
+} // namespace voltdb
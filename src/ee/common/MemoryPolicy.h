@@ -0,0 +1,79 @@
+/* This file is part of VoltDB.
+ * Copyright (C) 2008-2016 VoltDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with VoltDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MEMORYPOLICY_H_
+#define MEMORYPOLICY_H_
+
+#include <cstddef>
+
+namespace voltdb {
+
+/**
+ * Backing for the large, long lived blocks of the engine: tuple blocks,
+ * index node buffers, object slabs and temp pool chunks.
+ *
+ * Blocks close to the huge page size are rounded up to whole huge pages,
+ * and blocks of at least a huge page are aligned to one, so that the
+ * kernel can map them with huge pages, either transparently (madvise)
+ * or, for whole huge pages, from the explicitly reserved huge page pool
+ * (MAP_HUGETLB), falling back to transparent huge pages when the
+ * reserved pool is exhausted. Optionally, the pages of each block are
+ * placed on the NUMA node of the CPU that allocates it, which for a
+ * partition is the one its site thread runs on.
+ *
+ * The policy is process wide. It is read once from the environment:
+ *   VOLTDB_EE_HUGE_PAGES  none, transparent (the default) or explicit
+ *   VOLTDB_EE_NUMA_LOCAL  true to place blocks on the allocating node
+ * and may be changed with configure() before any engine is started.
+ */
+class MemoryPolicy {
+public:
+    enum HugePages {
+        HUGE_PAGES_NONE,
+        HUGE_PAGES_TRANSPARENT,
+        HUGE_PAGES_EXPLICIT
+    };
+
+    static const std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    static void configure(HugePages hugePages, bool localNode);
+    static HugePages hugePages();
+    static bool localNode();
+
+    /**
+     * Allocate a block of at least size bytes. Throws a fatal exception
+     * if the memory can't be mapped.
+     */
+    static void* allocateBlock(std::size_t size);
+
+    /**
+     * Release a block, which must be passed the same size it was
+     * allocated with.
+     */
+    static void freeBlock(void* block, std::size_t size);
+
+    /**
+     * The number of bytes of address space taken by a block of the
+     * given size, which is the size rounded up to whole pages, or to
+     * whole huge pages for blocks close to the huge page size.
+     */
+    static std::size_t mappedSize(std::size_t size);
+};
+
+} // namespace voltdb
+
+#endif // MEMORYPOLICY_H_
@@ -353,10 +353,9 @@ void NValue::createDecimalFromString(const std::string &txt) {
 struct NValueList {
     static int allocationSizeForLength(size_t length)
     {
-        //TODO: May want to consider extra allocation, here,
-        // such as space for a sorted copy of the array.
+        // Leave room for a sorted copy of the array after the array itself.
         // This allocation has the advantage of getting freed via NValue::free.
-        return (int)(sizeof(NValueList) + length*sizeof(StlFriendlyNValue));
+        return (int)(sizeof(NValueList) + 2*length*sizeof(StlFriendlyNValue));
     }
 
     void* operator new(size_t size, char* placement)
@@ -366,7 +365,8 @@ struct NValueList {
     void operator delete(void*, char*) {}
     void operator delete(void*) {}
 
-    NValueList(size_t length, ValueType elementType) : m_length(length), m_elementType(elementType)
+    NValueList(size_t length, ValueType elementType)
+        : m_length(length), m_elementType(elementType), m_sortable(false), m_sortedLength(0)
     { }
 
     void deserializeNValues(SerializeInputBE &input, Pool *dataPool)
@@ -374,13 +374,47 @@ struct NValueList {
         for (int ii = 0; ii < m_length; ++ii) {
             m_values[ii].deserializeFromAllocateForStorage(m_elementType, input, dataPool);
         }
+        // A deserialized (parameter) list does not change for the rest of
+        // the fragment, so it is worth sorting once for many lookups.
+        // Doubles are left out because NaN has no place in a sort order.
+        m_sortable = (m_length >= MIN_SORTED_LOOKUP_LENGTH) && (m_elementType != VALUE_TYPE_DOUBLE);
     }
 
     StlFriendlyNValue const* begin() const { return m_values; }
     StlFriendlyNValue const* end() const { return m_values + m_length; }
 
+    StlFriendlyNValue* sortedBegin() const
+    { return const_cast<StlFriendlyNValue*>(m_values + m_length); }
+
+    /**
+     * Find value in the list, with a binary search of the sorted copy when
+     * the list is sortable, or a scan of the values otherwise.
+     */
+    bool contains(const StlFriendlyNValue& value) const
+    {
+        if ( ! m_sortable) {
+            return std::find(begin(), end(), value) != end();
+        }
+        if (m_sortedLength == 0) {
+            StlFriendlyNValue* sorted = sortedBegin();
+            std::copy(begin(), end(), sorted);
+            std::sort(sorted, sorted + m_length);
+            m_sortedLength = std::unique(sorted, sorted + m_length) - sorted;
+        }
+        const StlFriendlyNValue* sorted = sortedBegin();
+        const StlFriendlyNValue* sortedEnd = sorted + m_sortedLength;
+        const StlFriendlyNValue* found = std::lower_bound(sorted, sortedEnd, value);
+        return found != sortedEnd && *found == value;
+    }
+
+    // Shorter lists are scanned as fast as they could be searched.
+    static const size_t MIN_SORTED_LOOKUP_LENGTH = 16;
+
     const size_t m_length;
     const ValueType m_elementType;
+    bool m_sortable;
+    // The number of unique values in the sorted copy, 0 until it is built.
+    mutable size_t m_sortedLength;
     StlFriendlyNValue m_values[0];
 };
 
@@ -408,11 +442,7 @@ bool NValue::inList(const NValue& rhs) const
     }
     const NValueList* listOfNValues = reinterpret_cast<const NValueList*>(rhs.getObjectValue_withoutNull());
     const StlFriendlyNValue& value = *static_cast<const StlFriendlyNValue*>(this);
-    //TODO: An O(ln(length)) implementation vs. the current O(length) implementation
-    // such as binary search would likely require some kind of sorting/re-org of values
-    // post-update/pre-lookup, and would likely require some sortable inequality method
-    // (operator<()?) to be defined on StlFriendlyNValue.
-    return std::find(listOfNValues->begin(), listOfNValues->end(), value) != listOfNValues->end();
+    return listOfNValues->contains(value);
 }
 
 void NValue::deserializeIntoANewNValueList(SerializeInputBE &input, Pool *dataPool)
@@ -424,8 +454,6 @@ void NValue::deserializeIntoANewNValueList(SerializeInputBE &input, Pool *dataPo
     ::memset(storage, 0, trueSize);
     NValueList* nvset = new (storage) NValueList(length, elementType);
     nvset->deserializeNValues(input, dataPool);
-    //TODO: An O(ln(length)) implementation vs. the current O(length) implementation of NValue::inList
-    // would likely require some kind of sorting/re-org of values at this point post-update pre-lookup.
 }
 
 void NValue::allocateANewNValueList(size_t length, ValueType elementType)
@@ -447,8 +475,10 @@ void NValue::setArrayElements(std::vector<NValue> &args) const
     while (ii--) {
         listOfNValues->m_values[ii] = args[ii];
     }
-    //TODO: An O(ln(length)) implementation vs. the current O(length) implementation of NValue::inList
-    // would likely require some kind of sorting/re-org of values at this point post-update pre-lookup.
+    // These lists are typically refilled for every row, so sorting them
+    // would cost more than the lookups it saves. Keep scanning them.
+    listOfNValues->m_sortable = false;
+    listOfNValues->m_sortedLength = 0;
 }
 
 int NValue::arrayLength() const
@@ -471,19 +501,17 @@ void NValue::castAndSortAndDedupArrayForInList(const ValueType outputType, std::
 {
     int size = arrayLength();
 
-    // make a set to eliminate unique values in O(nlogn) time
-    std::set<StlFriendlyNValue> uniques;
-
-    // iterate over the array of values and build a sorted set of unique
-    // values that don't overflow or violate unique constaints
-    // (n.b. sorted set means dups are removed)
+    // iterate over the array of values and collect the values
+    // that don't overflow or violate unique constaints
+    std::vector<StlFriendlyNValue> values;
+    values.reserve(size);
     for (int i = 0; i < size; i++) {
         const NValue& value = itemAtIndex(i);
         // cast the value to the right type and catch overflow/cast problems
         try {
             StlFriendlyNValue stlValue;
             stlValue = value.castAs(outputType);
-            uniques.insert(stlValue);
+            values.push_back(stlValue);
         }
         // cast exceptions mean the in-list test is redundant
         // don't include these values in the materialized table
@@ -491,11 +519,11 @@ void NValue::castAndSortAndDedupArrayForInList(const ValueType outputType, std::
         catch (SQLException &sqlException) {}
     }
 
-    // insert all items in the set in order
-    std::set<StlFriendlyNValue>::const_iterator iter;
-    for (iter = uniques.begin(); iter != uniques.end(); iter++) {
-        outList.push_back(*iter);
-    }
+    // sort and drop duplicates in O(nlogn) time, without the
+    // per-node allocations of a std::set
+    std::sort(values.begin(), values.end());
+    std::vector<StlFriendlyNValue>::iterator uniqueEnd = std::unique(values.begin(), values.end());
+    outList.insert(outList.end(), values.begin(), uniqueEnd);
 }
 
 void NValue::streamTimestamp(std::stringstream& value) const
@@ -722,6 +722,31 @@ class NValue {
         return copy;
     }
 
+    // Copy a value, giving any object storage an allocation of its own
+    // in persistent memory. The copy must be released with free().
+    NValue copyNValueToPersistentStorage() const
+    {
+        NValue copy = *this;
+        switch (getValueType()) {
+        case VALUE_TYPE_VARCHAR:
+        case VALUE_TYPE_VARBINARY:
+        case VALUE_TYPE_GEOGRAPHY:
+            if (isNull()) {
+                copy.setNullObjectPointer();
+            }
+            else {
+                int32_t length;
+                const char* source = getObject_withoutNull(&length);
+                copy.createObjectPointer(length, source, NULL);
+            }
+            copy.setSourceInlined(false);
+            break;
+        default:
+            break;
+        }
+        return copy;
+    }
+
     std::size_t getAllocationSizeForObject() const
     {
         if (isNull()) {
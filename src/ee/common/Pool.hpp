@@ -25,6 +25,7 @@
 #include <climits>
 #include <string.h>
 #include "common/FatalException.hpp"
+#include "common/MemoryPolicy.h"
 
 namespace voltdb {
 static const size_t TEMP_POOL_CHUNK_SIZE = 262144;
@@ -104,7 +105,7 @@ public:
             throwFatalException("Failed mmap");
         }
 #else
-        char *storage = new char[m_allocationSize];
+        char *storage = allocateChunk(0);
 #endif
         m_chunks.push_back(Chunk(m_allocationSize, storage));
     }
@@ -117,7 +118,7 @@ public:
                 throwFatalException("Failed munmap");
             }
 #else
-            delete [] m_chunks[ii].m_chunkData;
+            freeChunk(ii);
 #endif
         }
         for (std::size_t ii = 0; ii < m_oversizeChunks.size(); ii++) {
@@ -188,7 +189,7 @@ public:
                     throwFatalException("Failed mmap");
                 }
 #else
-                char *storage = new char[m_allocationSize];
+                char *storage = allocateChunk(m_chunks.size());
 #endif
                 m_chunks.push_back(Chunk(m_allocationSize, storage));
                 Chunk &newChunk = m_chunks.back();
@@ -252,7 +253,7 @@ public:
                     throwFatalException("Failed munmap");
                 }
 #else
-                delete []m_chunks[ii].m_chunkData;
+                freeChunk(ii);
 #endif
             }
             m_chunks.resize(m_maxChunkCount);
@@ -276,6 +277,27 @@ public:
     }
 
 private:
+    /*
+     * The chunks kept across purges are long lived and are mapped as the
+     * memory policy says. Any further ones are freed by the next purge,
+     * so they stay on the heap where they are reused warm.
+     */
+    char* allocateChunk(std::size_t index) {
+        if (index < m_maxChunkCount) {
+            return static_cast<char*>(MemoryPolicy::allocateBlock(m_allocationSize));
+        }
+        return new char[m_allocationSize];
+    }
+
+    void freeChunk(std::size_t index) {
+        if (index < m_maxChunkCount) {
+            MemoryPolicy::freeBlock(m_chunks[index].m_chunkData, m_allocationSize);
+        }
+        else {
+            delete [] m_chunks[index].m_chunkData;
+        }
+    }
+
     const uint64_t m_allocationSize;
     std::size_t m_maxChunkCount;
     std::size_t m_currentChunkIndex;
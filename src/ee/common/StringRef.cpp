@@ -25,6 +25,20 @@ using namespace voltdb;
 inline ThreadLocalPool::Sized* asSizedObject(char* stringPtr)
 { return reinterpret_cast<ThreadLocalPool::Sized*>(stringPtr); }
 
+// Embedded persistent strings are told apart from temporary strings,
+// which have the same layout, by this bit of their size prefix.
+static const int32_t EMBEDDED_SIZE_FLAG = 1 << 30;
+
+// The longest string (including the NValue length prefix) that gets
+// embedded, so that an embedded string fits the 64 byte size class.
+// Keeping to the few small size classes bounds the memory held in
+// partly used slabs, which -- unlike relocatable storage -- never compact.
+static const int32_t EMBEDDED_MAX_LENGTH =
+    static_cast<int32_t>(64 - sizeof(StringRef) - sizeof(ThreadLocalPool::Sized));
+
+inline int32_t objectLength(char* stringPtr)
+{ return asSizedObject(stringPtr)->m_size & ~EMBEDDED_SIZE_FLAG; }
+
 char* StringRef::getObjectValue()
 { return asSizedObject(m_stringPtr)->m_data; }
 
@@ -32,7 +46,7 @@ const char* StringRef::getObjectValue() const
 { return asSizedObject(m_stringPtr)->m_data; }
 
 int32_t StringRef::getObjectLength() const
-{ return asSizedObject(m_stringPtr)->m_size; }
+{ return objectLength(m_stringPtr); }
 
 const char* StringRef::getObject(int32_t* lengthOut) const
 {
@@ -42,12 +56,17 @@ const char* StringRef::getObject(int32_t* lengthOut) const
                              asSizedObject(m_stringPtr)->m_size)
               << std::endl;
     // */
-    *lengthOut = asSizedObject(m_stringPtr)->m_size;
+    *lengthOut = objectLength(m_stringPtr);
     return asSizedObject(m_stringPtr)->m_data;
 }
 
 int32_t StringRef::getAllocatedSize() const
 {
+    if (isEmbedded()) {
+        // The StringRef and the string share one slab slot.
+        return static_cast<int32_t>(ThreadLocalPool::getAllocationSizeForExactSizedObject(
+                embeddedAllocationSize(getObjectLength())));
+    }
     // The CompactingPool allocated a chunk of this size for storage.
     int32_t alloc_size = ThreadLocalPool::getAllocationSizeForRelocatable(asSizedObject(m_stringPtr));
     //cout << "Pool allocation size: " << alloc_size << endl;
@@ -85,6 +104,29 @@ inline StringRef::StringRef(Pool* unused, int32_t sz)
   : m_stringPtr(reinterpret_cast<char*>(this+1))
 { asSizedObject(m_stringPtr)->m_size = sz; }
 
+bool StringRef::isEmbedded() const
+{
+    return m_stringPtr == reinterpret_cast<const char*>(this+1) &&
+        (asSizedObject(m_stringPtr)->m_size & EMBEDDED_SIZE_FLAG) != 0;
+}
+
+std::size_t StringRef::embeddedAllocationSize(int32_t sz)
+{ return sizeof(StringRef) + sizeof(ThreadLocalPool::Sized) + sz; }
+
+// Embedded strings use the temporary string layout, with the string
+// data just past the StringRef, but in storage of their own.
+StringRef* StringRef::createEmbedded(int32_t sz)
+{
+#ifdef MEMCHECK
+    void* storage = new char[embeddedAllocationSize(sz)];
+#else
+    void* storage = ThreadLocalPool::allocateExactSizedObject(embeddedAllocationSize(sz));
+#endif
+    StringRef* result = new (storage) StringRef(static_cast<Pool*>(NULL), sz);
+    asSizedObject(result->m_stringPtr)->m_size |= EMBEDDED_SIZE_FLAG;
+    return result;
+}
+
 // The destroy method keeps this from getting run on temporary strings.
 inline StringRef::~StringRef()
 {
@@ -105,6 +147,9 @@ StringRef* StringRef::create(int32_t sz, const char* source, Pool* tempPool)
     if (tempPool) {
         result = new (tempPool->allocate(sizeof(StringRef)+sizeof(ThreadLocalPool::Sized) + sz)) StringRef(tempPool, sz);
     }
+    else if (sz <= EMBEDDED_MAX_LENGTH) {
+        result = createEmbedded(sz);
+    }
     else {
 #ifdef MEMCHECK
         result = new StringRef(sz);
@@ -136,13 +181,23 @@ StringRef::destroy(StringRef* sref)
     // is purged or destroyed. They MUST NOT be deallocated here and now.
     // Pointer math provides an easy way (sref+1) to calculate the address
     // contiguous to the end of the StringRef object.
-    // Persistent strings can never pass this test because they
+    // Relocatable persistent strings can never pass this test because they
     // set m_stringPtr only to an address that is at some offset into an
     // allocation that is separate from the StringRef. Even in the
     // unlikely event that the two allocations were very close to each other,
     // they would still be separated by that offset and would fail this
     // test.
+    // Embedded persistent strings do pass it, and are told apart by the
+    // flag in their size prefix. Their one allocation is freed here.
     if (sref->m_stringPtr == reinterpret_cast<char*>(sref+1)) {
+        if ( ! sref->isEmbedded()) {
+            return;
+        }
+#ifdef MEMCHECK
+        delete [] reinterpret_cast<char*>(sref);
+#else
+        ThreadLocalPool::freeExactSizedObject(embeddedAllocationSize(sref->getObjectLength()), sref);
+#endif
         return;
     }
     delete sref;
@@ -18,6 +18,7 @@
 #ifndef STRINGREF_H
 #define STRINGREF_H
 
+#include <cstddef>
 #include <stdint.h>
 
 namespace voltdb
@@ -72,6 +73,13 @@ private:
     StringRef(int32_t size);
     // Signature used internally for temporary strings
     StringRef(Pool* tempPool, int32_t size);
+
+    // Persistent strings this short are allocated in one piece with
+    // their StringRef, like temporary strings, rather than in relocatable
+    // storage, which saves an allocation and a pointer chase per access.
+    static StringRef* createEmbedded(int32_t size);
+    static std::size_t embeddedAllocationSize(int32_t size);
+    bool isEmbedded() const;
     // Only called from destroy and only for persistent strings.
     ~StringRef();
 
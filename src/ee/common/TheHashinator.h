@@ -74,6 +74,17 @@ class TheHashinator {
         }
     }
 
+    /**
+     * Pick a partition for each of count values, as hashinate(NValue) would,
+     * and write them to partitionsOut.
+     */
+    void hashinateAll(const NValue *values, size_t count, int32_t *partitionsOut) const
+    {
+        for (size_t ii = 0; ii < count; ++ii) {
+            partitionsOut[ii] = hashinate(values[ii]);
+        }
+    }
+
     /*
      * Given a previously calculated hash value pick the partition to store the data in
      */
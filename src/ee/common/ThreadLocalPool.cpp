@@ -17,6 +17,7 @@
 #include "common/ThreadLocalPool.h"
 
 #include "common/FatalException.hpp"
+#include "common/MemoryPolicy.h"
 #include "common/SQLException.h"
 
 #include "structures/CompactingPool.h"
@@ -24,18 +25,43 @@
 #include <boost/shared_ptr.hpp>
 #include <boost/unordered_map.hpp>
 
+#include <cstdlib>
 #include <iostream>
 #include <pthread.h>
+#include <vector>
 
 namespace voltdb {
 
-struct voltdb_pool_allocator_new_delete
-{
-    typedef std::size_t size_type;
-    typedef std::ptrdiff_t difference_type;
-
-    static char * malloc(const size_type bytes);
-    static void free(char * const block);
+/**
+ * A pool of equally sized objects carved out of large slabs.
+ * Freed objects are kept on an intrusive free list threaded through
+ * the objects themselves, so there is no per-object overhead. All
+ * pools are thread local, so none of this needs any locking.
+ */
+class SlabPool {
+public:
+    SlabPool(std::size_t objectSize);
+    ~SlabPool();
+
+    void* malloc();
+    void free(void* object);
+
+    std::size_t objectSize() const { return m_objectSize; }
+    std::size_t liveObjects() const { return m_liveObjects; }
+    std::size_t slabBytes() const { return m_slabs.size() * m_slabSize; }
+
+private:
+    void* allocateSlab();
+
+    const std::size_t m_objectSize;
+    const std::size_t m_slabSize;
+    std::vector<char*> m_slabs;
+    // Head of the list of freed objects, each of which holds the next.
+    void* m_freeList;
+    // The not yet used tail of the newest slab.
+    char* m_unusedStart;
+    char* m_unusedEnd;
+    std::size_t m_liveObjects;
 };
 
 // This needs to be >= the VoltType.MAX_VALUE_LENGTH defined in java, currently 1048576.
@@ -54,9 +80,9 @@ static pthread_key_t m_stringKey;
 static pthread_key_t m_keyAllocated;
 static pthread_once_t m_keyOnce = PTHREAD_ONCE_INIT;
 
-typedef boost::pool<voltdb_pool_allocator_new_delete> PoolForObjectSize;
-typedef boost::shared_ptr<PoolForObjectSize> PoolForObjectSizePtr;
-typedef boost::unordered_map<std::size_t, PoolForObjectSizePtr> PoolsByObjectSize;
+typedef boost::shared_ptr<SlabPool> SlabPoolPtr;
+// Indexed by size class, see getSizeClass.
+typedef std::vector<SlabPoolPtr> PoolsByObjectSize;
 
 typedef std::pair<int, PoolsByObjectSize* > PairType;
 typedef PairType* PairTypePtr;
@@ -238,65 +264,161 @@ void ThreadLocalPool::freeRelocatable(Sized* sized)
 
 #endif
 
-void* ThreadLocalPool::allocateExactSizedObject(std::size_t sz)
+// Objects up to this size are rounded up to a multiple of 8 bytes,
+// which is also the smallest class, big enough for the free list link.
+static const std::size_t SMALL_SIZE_CLASS_LIMIT = 64;
+static const std::size_t SMALL_SIZE_CLASS_GRAIN = 8;
+static const std::size_t SLAB_SIZE = 2 * 1024 * 1024;
+
+/**
+ * Map an object size to its size class. Small sizes use 8 byte steps,
+ * beyond that each power of 2 is split in two by a class at one and a
+ * half times the previous power, which bounds the rounding waste to a
+ * third of the object.
+ */
+static std::size_t getSizeClass(std::size_t sz, std::size_t& classSize)
 {
-    PoolsByObjectSize& pools =
-            *(static_cast< PairTypePtr >(pthread_getspecific(m_key))->second);
-    PoolsByObjectSize::iterator iter = pools.find(sz);
-    PoolForObjectSize* pool;
-    if (iter == pools.end()) {
-        pool = new PoolForObjectSize(sz);
-        PoolForObjectSizePtr poolPtr(pool);
-        pools.insert(std::pair<std::size_t, PoolForObjectSizePtr>(sz, poolPtr));
+    if (sz <= SMALL_SIZE_CLASS_LIMIT) {
+        std::size_t index = (sz == 0) ? 0 : (sz - 1) / SMALL_SIZE_CLASS_GRAIN;
+        classSize = (index + 1) * SMALL_SIZE_CLASS_GRAIN;
+        return index;
     }
-    else {
-        pool = iter->second.get();
+    // 2^log2 < sz <= 2^(log2 + 1)
+    int log2 = static_cast<int>(sizeof(unsigned long) * 8) - 1 -
+        __builtin_clzl(static_cast<unsigned long>(sz - 1));
+    std::size_t power = static_cast<std::size_t>(1) << log2;
+    std::size_t index = SMALL_SIZE_CLASS_LIMIT / SMALL_SIZE_CLASS_GRAIN + (log2 - 6) * 2;
+    if (sz <= power + (power >> 1)) {
+        classSize = power + (power >> 1);
+        return index;
     }
-    /**
-     * The goal of this code is to bypass the pool sizing algorithm used by
-     * boost and replace it with something that bounds allocations to a series
-     * of 2MB blocks for small allocation sizes. For larger allocations
-     * (not a typical case, possibly not a useful case), fall back to
-     * allocating two of these huge things at a time.
-     * The goal of this bounding is to make the amount of unused but allocated
-     * memory relatively small so that the counting done by the volt allocator
-     * accurately represents the effect on RSS. Left to its own algorithms,
-     * boost will purposely allocate pages that increase in size until they
-     * are too large to ever overflow, regardless of absolute scale.
-     * That makes it likely that they will contain lots of unused space
-     * (for safety against repeated allocations). VoltDB prefers
-     * to risk lots of separate smaller allocations (~2MB each) at larger
-     * scale rather than risk fewer, larger, but mostly unused buffers.
-     * Also, for larger allocation requests (not typical -- not used? -- in
-     * VoltDB, boost will _start_ with very large blocks, while VoltDB would
-     * prefer to start smaller with just 2 allocations per block.
-     */
-    if (pool->get_next_size() * pool->get_requested_size() > (1024 * 1024 * 2)) {
-        //If the size of objects served by this pool is less than 256 kilobytes
-        // plan to allocate a 2MB block, but no larger, even if it eventually
-        // requires more blocks than boost would normally allocate.
-        if (pool->get_requested_size() < (1024 * 256)) {
-            pool->set_next_size((1024 * 1024 * 2) /  pool->get_requested_size());
-        } else {
-            //For large objects allocated just two of them
-            pool->set_next_size(2);
-        }
+    classSize = power << 1;
+    return index + 1;
+}
+
+int TestOnlySizeClassForObject(int length)
+{
+    std::size_t classSize;
+    getSizeClass(length, classSize);
+    return static_cast<int>(classSize);
+}
+
+static std::size_t& getAllocatedBytes()
+{
+    return *static_cast<std::size_t*>(pthread_getspecific(m_keyAllocated));
+}
+
+SlabPool::SlabPool(std::size_t objectSize)
+    : m_objectSize(objectSize),
+      // Small objects share 2MB slabs. For larger objects (not typical)
+      // allocate just two of them at a time, as the unused space in a
+      // slab counts against RSS.
+      m_slabSize(objectSize < (1024 * 256) ? (SLAB_SIZE / objectSize) * objectSize : 2 * objectSize),
+      m_freeList(NULL),
+      m_unusedStart(NULL),
+      m_unusedEnd(NULL),
+      m_liveObjects(0)
+{
+}
+
+SlabPool::~SlabPool()
+{
+    std::size_t& allocated = getAllocatedBytes();
+    for (std::vector<char*>::iterator iter = m_slabs.begin(); iter != m_slabs.end(); ++iter) {
+        MemoryPolicy::freeBlock(*iter, m_slabSize);
+        allocated -= m_slabSize;
+    }
+}
+
+void* SlabPool::allocateSlab()
+{
+    // Slabs that fill a whole huge page get one where the memory policy
+    // allows, which saves TLB misses on hot objects.
+    void* slab = MemoryPolicy::allocateBlock(m_slabSize);
+    m_slabs.push_back(static_cast<char*>(slab));
+    getAllocatedBytes() += m_slabSize;
+    return slab;
+}
+
+inline void* SlabPool::malloc()
+{
+    ++m_liveObjects;
+    if (m_freeList != NULL) {
+        void* object = m_freeList;
+        m_freeList = *static_cast<void**>(object);
+        return object;
+    }
+    if (m_unusedStart == m_unusedEnd) {
+        m_unusedStart = static_cast<char*>(allocateSlab());
+        m_unusedEnd = m_unusedStart + m_slabSize;
+    }
+    void* object = m_unusedStart;
+    m_unusedStart += m_objectSize;
+    return object;
+}
+
+inline void SlabPool::free(void* object)
+{
+    --m_liveObjects;
+    *static_cast<void**>(object) = m_freeList;
+    m_freeList = object;
+}
+
+static PoolsByObjectSize& getExactSizedPools()
+{
+    return *(static_cast< PairTypePtr >(pthread_getspecific(m_key))->second);
+}
+
+void* ThreadLocalPool::allocateExactSizedObject(std::size_t sz)
+{
+    PoolsByObjectSize& pools = getExactSizedPools();
+    std::size_t classSize;
+    std::size_t sizeClass = getSizeClass(sz, classSize);
+    if (sizeClass >= pools.size()) {
+        pools.resize(sizeClass + 1);
+    }
+    SlabPool* pool = pools[sizeClass].get();
+    if (pool == NULL) {
+        pool = new SlabPool(classSize);
+        pools[sizeClass].reset(pool);
     }
     return pool->malloc();
 }
 
 void ThreadLocalPool::freeExactSizedObject(std::size_t sz, void* object)
 {
-    PoolsByObjectSize& pools =
-            *(static_cast< PairTypePtr >(pthread_getspecific(m_key))->second);
-    PoolsByObjectSize::iterator iter = pools.find(sz);
-    if (iter == pools.end()) {
+    PoolsByObjectSize& pools = getExactSizedPools();
+    std::size_t classSize;
+    std::size_t sizeClass = getSizeClass(sz, classSize);
+    if (sizeClass >= pools.size() || pools[sizeClass].get() == NULL) {
         throwFatalException(
                 "Failed to locate an allocated object of size %ld to free it.",
                 static_cast<long>(sz));
     }
-    PoolForObjectSize* pool = iter->second.get();
-    pool->free(object);
+    pools[sizeClass]->free(object);
+}
+
+std::size_t ThreadLocalPool::getAllocationSizeForExactSizedObject(std::size_t sz)
+{
+    std::size_t classSize;
+    getSizeClass(sz, classSize);
+    return classSize;
+}
+
+void ThreadLocalPool::getExactSizedPoolStats(std::vector<SizeClassStats>& stats)
+{
+    stats.clear();
+    PoolsByObjectSize& pools = getExactSizedPools();
+    for (PoolsByObjectSize::iterator iter = pools.begin(); iter != pools.end(); ++iter) {
+        if (iter->get() == NULL) {
+            continue;
+        }
+        SizeClassStats classStats;
+        classStats.m_objectSize = (*iter)->objectSize();
+        classStats.m_liveObjects = (*iter)->liveObjects();
+        classStats.m_slabBytes = (*iter)->slabBytes();
+        stats.push_back(classStats);
+    }
 }
 
 std::size_t ThreadLocalPool::getPoolAllocationSize() {
@@ -314,17 +436,4 @@ std::size_t ThreadLocalPool::getPoolAllocationSize() {
     }
     return bytes_allocated;
 }
-
-char * voltdb_pool_allocator_new_delete::malloc(const size_type bytes) {
-    (*static_cast< std::size_t* >(pthread_getspecific(m_keyAllocated))) += bytes + sizeof(std::size_t);
-    //std::cout << "Pooled memory is " << ((*static_cast< std::size_t* >(pthread_getspecific(m_keyAllocated))) / (1024 * 1024)) << " after requested allocation " << (bytes / (1024 * 1024)) <<  std::endl;
-    char *retval = new (std::nothrow) char[bytes + sizeof(std::size_t)];
-    *reinterpret_cast<std::size_t*>(retval) = bytes + sizeof(std::size_t);
-    return &retval[sizeof(std::size_t)];
-}
-
-void voltdb_pool_allocator_new_delete::free(char * const block) {
-    (*static_cast< std::size_t* >(pthread_getspecific(m_keyAllocated))) -= *reinterpret_cast<std::size_t*>(block - sizeof(std::size_t));
-    delete [](block - sizeof(std::size_t));
-}
 }
@@ -18,9 +18,10 @@
 #ifndef THREADLOCALPOOL_H_
 #define THREADLOCALPOOL_H_
 
-#include "boost/pool/pool.hpp"
 #include "boost/shared_ptr.hpp"
 
+#include <vector>
+
 namespace voltdb {
 
 /**
@@ -48,20 +49,31 @@ public:
         Sized(int32_t requested_size) : m_size(requested_size) { }
     };
 
+    /// Memory use of one size class of allocateExactSizedObject.
+    /// The unused part of the slabs, m_slabBytes less
+    /// m_liveObjects * m_objectSize, is the fragmentation.
+    struct SizeClassStats {
+        std::size_t m_objectSize;
+        std::size_t m_liveObjects;
+        std::size_t m_slabBytes;
+    };
+
     static const int POOLED_MAX_VALUE_LENGTH;
 
     /**
-     * Allocate space from a page of objects of the requested size.
-     * Each new size of object splinters the allocated memory into a new pool
-     * which is a collection of pages of objects of that exact size.
+     * Allocate space from a slab of objects of the requested size class.
+     * Sizes are rounded up to a multiple of 8 bytes up to 64 bytes, and to
+     * the next power of 2 or power of 2 and a half beyond that, so that
+     * objects of similar sizes share a pool rather than each splintering
+     * the allocated memory into a pool of its own.
      * Each pool will allocate additional space that is initally unused.
      * This is not an issue when the allocated objects will be instances of a
      * class that has many instances to quickly fill up the unused space. So,
      * an optimal use case is a custom operator new for a commonly used class.
-     * Page sizes in a pool may vary as the number of required pages grows,
-     * but will be bounded to 2MB or to the size of two objects if they are
-     * larger than 256KB (not typical). There is no fixed upper limit to the
-     * size of object that can be requested.
+     * Slabs are 2MB, aligned so that they can be backed by a huge page,
+     * or hold just two objects if they are larger than 256KB (not typical).
+     * There is no fixed upper limit to the size of object that can be
+     * requested.
      * This allocation method would be a poor choice for variable-length
      * buffers whose sizes depend on user input and may be unlikely to repeat.
      * allocateRelocatable is the better fit for that use case.
@@ -75,6 +87,18 @@ public:
 
     static std::size_t getPoolAllocationSize();
 
+    /**
+     * Fill stats with the memory use of each size class in use by
+     * allocateExactSizedObject on this thread.
+     */
+    static void getExactSizedPoolStats(std::vector<SizeClassStats>& stats);
+
+    /**
+     * Return the rounded-up size of the slab slot that
+     * allocateExactSizedObject sets aside for an object of the given size.
+     */
+    static std::size_t getAllocationSizeForExactSizedObject(std::size_t size);
+
     /**
      * Allocate space from a page of objects of approximately the requested
      * size. There will be relatively small gaps of unused space between the
@@ -363,6 +363,40 @@ bool TupleSchema::isCompatibleForMemcpy(const TupleSchema *other) const
     return true;
 }
 
+bool TupleSchema::canRelaxTo(const TupleSchema *other) const
+{
+    if ( ! isCompatibleForMemcpy(other)) {
+        return false;
+    }
+
+    for (int ii = 0; ii < totalColumnCount(); ii++) {
+        const ColumnInfo *columnInfo = getColumnInfoPrivate(ii);
+        const ColumnInfo *ocolumnInfo = other->getColumnInfoPrivate(ii);
+        if (columnInfo->inBytes != ocolumnInfo->inBytes) {
+            return false;
+        }
+        if (columnInfo->allowNull && ! ocolumnInfo->allowNull) {
+            return false;
+        }
+        if (columnInfo->inlined ? (columnInfo->length != ocolumnInfo->length)
+                                : (columnInfo->length > ocolumnInfo->length)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void TupleSchema::relaxTo(const TupleSchema *other)
+{
+    assert(canRelaxTo(other));
+    for (int ii = 0; ii < totalColumnCount(); ii++) {
+        ColumnInfo *columnInfo = getColumnInfoPrivate(ii);
+        const ColumnInfo *ocolumnInfo = other->getColumnInfoPrivate(ii);
+        columnInfo->length = ocolumnInfo->length;
+        columnInfo->allowNull = ocolumnInfo->allowNull;
+    }
+}
+
 bool TupleSchema::equals(const TupleSchema *other) const
 {
     // First check for structural equality.
@@ -168,6 +168,17 @@ public:
      * same.  Includes hidden columns. */
     bool isCompatibleForMemcpy(const TupleSchema *other) const;
 
+    /* Returns true if this schema can take on the column lengths and
+     * nullability of other without changing the tuple format: the two
+     * must be compatible for memcpy, inlined columns must keep their
+     * length, out-of-line columns may only grow, and a column may
+     * start to allow nulls but not stop. */
+    bool canRelaxTo(const TupleSchema *other) const;
+
+    /* Takes on the column lengths and nullability of other, which
+     * canRelaxTo must have accepted. */
+    void relaxTo(const TupleSchema *other);
+
     /** Returns column info object for columnIndex-th (visible) column.  */
     const ColumnInfo* getColumnInfo(int columnIndex) const;
     ColumnInfo* getColumnInfo(int columnIndex);
@@ -146,6 +146,8 @@ public:
         return reinterpret_cast<T>(::memcpy(m_dataPool->allocate(sz), original, sz));
     }
 
+    char* allocatePooled(std::size_t sz) { return reinterpret_cast<char*>(m_dataPool->allocate(sz)); }
+
     void* allocateAction(size_t sz) { return m_dataPool->allocate(sz); }
 
 private:
@@ -141,13 +141,30 @@ Table* ExecutorContext::executeExecutors(const std::vector<AbstractExecutor*>& e
     // therefore dependency tracking is not needed here.
     size_t ttl = executorList.size();
     int ctr = 0;
+    bool profiling = m_engine != NULL && m_engine->isProfilingExecutors();
 
     try {
+        if (profiling) {
+            BOOST_FOREACH (AbstractExecutor *executor, executorList) {
+                executor->markProfiledOutput();
+            }
+        }
+
+        // Executors with pipelined input receive tuples from their children
+        // before they execute themselves, so get them ready first.
+        BOOST_FOREACH (AbstractExecutor *executor, executorList) {
+            if (executor->hasPipelinedInput()) {
+                executor->startPipelinedInput(*m_staticParams);
+            }
+        }
+
         BOOST_FOREACH (AbstractExecutor *executor, executorList) {
             assert(executor);
             // Call the execute method to actually perform whatever action
             // it is that the node is supposed to do...
-            if (!executor->execute(*m_staticParams)) {
+            bool succeeded = profiling ? executor->executeWithProfile(*m_staticParams) :
+                                         executor->execute(*m_staticParams);
+            if (!succeeded) {
                 throw SerializableEEException(VOLT_EE_EXCEPTION_TYPE_EEEXCEPTION,
                     "Unspecified execution error detected");
             }
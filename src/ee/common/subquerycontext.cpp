@@ -0,0 +1,116 @@
+/* This file is part of VoltDB.
+ * Copyright (C) 2008-2016 VoltDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with VoltDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/subquerycontext.h"
+
+#include "common/tabletuple.h"
+#include "storage/TempTableLimits.h"
+#include "storage/tableiterator.h"
+#include "storage/temptable.h"
+
+namespace voltdb {
+
+// Cached results are usually a handful of rows, so start with a small chunk.
+static const uint64_t RESULT_CACHE_CHUNK_SIZE = 16 * 1024;
+// The budget for the cache when the fragment has no temp table memory limit
+static const int64_t UNLIMITED_RESULT_CACHE_BYTES = 50 * 1024 * 1024;
+
+SubqueryResultCache::SubqueryResultCache(TempTableLimits* limits)
+  : m_pool(RESULT_CACHE_CHUNK_SIZE, 1)
+  , m_limits(limits)
+  , m_reportedBytes(0)
+  , m_full(false)
+{ }
+
+SubqueryResultCache::~SubqueryResultCache()
+{
+    if (m_limits != NULL) {
+        m_limits->reduceAllocated(static_cast<int>(m_reportedBytes));
+    }
+}
+
+bool SubqueryResultCache::loadResult(const std::vector<NValue>& params, TempTable* outputTable) const
+{
+    ResultMap::const_iterator it = m_results.find(params);
+    if (it == m_results.end()) {
+        return false;
+    }
+    // The cached copies outlive the output table's contents, so a shallow insert will do.
+    const std::vector<char*>& rows = it->second;
+    TableTuple tuple(outputTable->schema());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        tuple.move(rows[i]);
+        outputTable->insertTempTuple(tuple);
+    }
+    return true;
+}
+
+void SubqueryResultCache::storeResult(const std::vector<NValue>& params, TempTable* outputTable)
+{
+    if (m_full) {
+        return;
+    }
+
+    const TupleSchema* schema = outputTable->schema();
+    const size_t tupleLength = schema->tupleLength() + TUPLE_HEADER_SIZE;
+    const uint16_t uninlinedCount = schema->getUninlinedObjectColumnCount();
+
+    // Size up the copy before making it.
+    int64_t resultBytes = outputTable->activeTupleCount() * (tupleLength + sizeof(char*));
+    TableTuple tuple(schema);
+    if (uninlinedCount > 0) {
+        TableIterator iterator = outputTable->iterator();
+        while (iterator.next(tuple)) {
+            for (uint16_t i = 0; i < uninlinedCount; ++i) {
+                NValue value = tuple.getNValue(schema->getUninlinedObjectColumnInfoIndex(i));
+                resultBytes += value.getAllocationSizeForObject();
+            }
+        }
+    }
+    // The pool's first chunk is only reported once a result is stored, and
+    // the copy may need a new chunk on top of the rows themselves.
+    resultBytes += RESULT_CACHE_CHUNK_SIZE;
+
+    int64_t budget = UNLIMITED_RESULT_CACHE_BYTES;
+    int64_t inUse = m_pool.getAllocatedMemory();
+    if (m_limits != NULL && m_limits->getMemoryLimit() >= 0) {
+        budget = m_limits->getMemoryLimit() / 2;
+        inUse = m_limits->getAllocated();
+    }
+    if (inUse + resultBytes > budget) {
+        m_full = true;
+        return;
+    }
+
+    std::vector<char*>& rows = m_results[params];
+    rows.reserve(static_cast<size_t>(outputTable->activeTupleCount()));
+    TableIterator iterator = outputTable->iterator();
+    while (iterator.next(tuple)) {
+        char* storage = static_cast<char*>(m_pool.allocateZeroes(tupleLength));
+        TableTuple copy(storage, schema);
+        copy.copyForPersistentInsert(tuple, &m_pool);
+        rows.push_back(storage);
+    }
+
+    if (m_limits != NULL) {
+        int64_t allocated = m_pool.getAllocatedMemory();
+        m_limits->increaseAllocated(static_cast<int>(allocated - m_reportedBytes));
+        m_reportedBytes = allocated;
+    }
+}
+
+} // namespace voltdb
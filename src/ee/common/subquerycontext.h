@@ -20,10 +20,78 @@
 
 #include <vector>
 
+#include "boost/shared_ptr.hpp"
+#include "boost/unordered_map.hpp"
+
 #include "common/NValue.hpp"
+#include "common/Pool.hpp"
 
 namespace voltdb {
 
+class TempTable;
+class TempTableLimits;
+
+/*
+* Results of earlier invocations of a correlated subquery, keyed by the values of all
+* the parameters they were computed with, so that any recurring combination of
+* correlation values -- not just a repeat of the last one -- can skip re-running
+* the subquery's executors.
+* Cached rows are deep copies held in the cache's own pool, which is charged to the
+* fragment's TempTableLimits. The cache stops admitting new results once that would
+* take the fragment's temp table memory past half of its limit, so caching never
+* causes a query to fail.
+*/
+class SubqueryResultCache {
+public:
+    SubqueryResultCache(TempTableLimits* limits);
+    ~SubqueryResultCache();
+
+    /** Refill outputTable with the rows cached for params. Return false if there are none. */
+    bool loadResult(const std::vector<NValue>& params, TempTable* outputTable) const;
+
+    /** Remember the rows currently in outputTable as the result for params, if there is room. */
+    void storeResult(const std::vector<NValue>& params, TempTable* outputTable);
+
+private:
+    struct ParamsHasher : std::unary_function<std::vector<NValue>, std::size_t>
+    {
+        std::size_t operator()(const std::vector<NValue>& params) const
+        {
+            std::size_t seed = 0;
+            for (size_t i = 0; i < params.size(); ++i) {
+                params[i].hashCombine(seed);
+            }
+            return seed;
+        }
+    };
+
+    struct ParamsEqualityChecker
+    {
+        bool operator()(const std::vector<NValue>& lhs, const std::vector<NValue>& rhs) const
+        {
+            assert(lhs.size() == rhs.size());
+            for (size_t i = 0; i < lhs.size(); ++i) {
+                if (lhs[i].compare(rhs[i]) != VALUE_COMPARE_EQUAL) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    typedef boost::unordered_map<std::vector<NValue>, std::vector<char*>,
+                                 ParamsHasher, ParamsEqualityChecker> ResultMap;
+
+    ResultMap m_results;
+    // Storage for the cached rows and their out-of-line values
+    Pool m_pool;
+    TempTableLimits* m_limits;
+    // The part of m_pool's memory reported to m_limits
+    int64_t m_reportedBytes;
+    // Set once a result did not fit, after which no more are cached
+    bool m_full;
+};
+
 /*
 * Keep track of the actual parameter values coming into a subquery invocation
 * and if they have not changed since last invocation reuses the cached result
@@ -34,6 +102,8 @@ namespace voltdb {
 *    by columns from the join's OUTER side would effectively get run once per OUTER row.
 * -- subqueries that were correlated by a parent's indexed column (producing ordered values)
 *    could get executed once per unique value.
+* When the parameters have changed, the result cache is consulted before the subquery
+* is re-run.
 * The subquery context is registered with the global executor context as candidates for
 * post-fragment cleanup, allowing results to be retained between invocations.
 */
@@ -46,6 +116,7 @@ struct SubqueryContext {
     SubqueryContext(const SubqueryContext& other)
       : m_hasValidResult(other.m_hasValidResult)
       , m_lastParams(other.m_lastParams)
+      , m_resultCache(other.m_resultCache)
     {
         if (m_hasValidResult) {
             m_lastResult = other.m_lastResult;
@@ -65,12 +136,26 @@ struct SubqueryContext {
 
     std::vector<NValue>& accessLastParams() { return m_lastParams; }
 
+    /** Return the result cache, creating it on first use. */
+    SubqueryResultCache* getResultCache(TempTableLimits* limits)
+    {
+        if (m_resultCache.get() == NULL) {
+            m_resultCache.reset(new SubqueryResultCache(limits));
+        }
+        return m_resultCache.get();
+    }
+
+    SubqueryResultCache* getResultCache() const { return m_resultCache.get(); }
+
 private:
     bool m_hasValidResult;
     NValue m_lastResult;
     // The parameter values that were used to obtain the last result in the ascending
     // order of the parameter indexes
     std::vector<NValue> m_lastParams;
+    // Shared by the copies of this context; released when the last one goes away
+    // at the end of the fragment.
+    boost::shared_ptr<SubqueryResultCache> m_resultCache;
 };
 
 }
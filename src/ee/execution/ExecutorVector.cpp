@@ -51,6 +51,10 @@
 #include "plannodes/abstractplannode.h"
 #include "plannodes/abstractplannode.h"
 #include "executors/executorfactory.h"
+#include "common/TupleSchema.h"
+#include "common/ValueFactory.hpp"
+#include "storage/tablefactory.h"
+#include "storage/temptable.h"
 
 #include "boost/foreach.hpp"
 
@@ -122,6 +126,7 @@ void ExecutorVector::init(VoltDBEngine* engine) {
             initPlanNode(engine, planNode);
             executorList->push_back(planNode->getExecutor());
         }
+        setupPipelines(*executorList);
         m_subplanExecListMap.insert(make_pair(it->first, executorList.get()));
         executorList.release();
     }
@@ -181,11 +186,207 @@ void ExecutorVector::initPlanNode(VoltDBEngine* engine, AbstractPlanNode* node)
     throw SerializableEEException(VOLT_EE_EXCEPTION_TYPE_EEEXCEPTION, msg);
 }
 
+/**
+ * Return true if an inline LIMIT anywhere under the node may need to count
+ * the rows the node has output so far.
+ */
+static bool hasInlineLimit(AbstractPlanNode* node) {
+    std::map<PlanNodeType, AbstractPlanNode*>::const_iterator it;
+    for (it = node->getInlinePlanNodes().begin(); it != node->getInlinePlanNodes().end(); ++it) {
+        if (it->first == PLAN_NODE_TYPE_LIMIT || hasInlineLimit(it->second)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Return true if the node's executor writes all of its output tuples one
+ * at a time through TempTable::insertTempTuple and never looks at them
+ * again, so that they can be pushed to its parent instead.
+ */
+static bool canPushOutput(AbstractPlanNode* node) {
+    switch (node->getPlanNodeType()) {
+    case PLAN_NODE_TYPE_SEQSCAN:
+    case PLAN_NODE_TYPE_INDEXSCAN:
+    case PLAN_NODE_TYPE_NESTLOOP:
+    case PLAN_NODE_TYPE_NESTLOOPINDEX:
+    case PLAN_NODE_TYPE_PROJECTION:
+        break;
+    default:
+        return false;
+    }
+    // A scan with nothing to filter or project outputs its input table as is.
+    TempTable* output = node->getExecutor()->getTempOutputTable();
+    if (output == NULL || output != node->getOutputTable()) {
+        return false;
+    }
+    // The LIMIT is enforced by counting the rows in the output table.
+    return ! hasInlineLimit(node);
+}
+
+void ExecutorVector::setupPipelines(const std::vector<AbstractExecutor*>& executorList) {
+    // Where a parent can consume its input one tuple at a time, have its
+    // children push their output tuples straight into it, so that the
+    // intermediate results are not materialized. Pipeline breakers like
+    // sort and aggregation are not consumers, and keep their input tables.
+    BOOST_FOREACH (AbstractExecutor* executor, executorList) {
+        TempTableTupleSink* sink = executor->getPipelinedInputSink();
+        if (sink == NULL) {
+            continue;
+        }
+        const std::vector<AbstractPlanNode*>& children = executor->getPlanNode()->getChildren();
+        bool canPipeline = ! children.empty();
+        BOOST_FOREACH (AbstractPlanNode* child, children) {
+            if ( ! canPushOutput(child)) {
+                canPipeline = false;
+                break;
+            }
+        }
+        if ( ! canPipeline) {
+            continue;
+        }
+        BOOST_FOREACH (AbstractPlanNode* child, children) {
+            child->getExecutor()->getTempOutputTable()->setPipelineSink(sink);
+        }
+        executor->setPipelinedInput();
+    }
+}
+
 void ExecutorVector::setupContext(ExecutorContext* executorContext)
     { executorContext->setupForExecutors(&m_subplanExecListMap); }
 
 void ExecutorVector::resetLimitStats() { m_limits.resetPeakMemory(); }
 
+static void resetInlineProfiles(AbstractPlanNode* node) {
+    std::map<PlanNodeType, AbstractPlanNode*>::const_iterator it;
+    for (it = node->getInlinePlanNodes().begin(); it != node->getInlinePlanNodes().end(); ++it) {
+        it->second->getExecutor()->getProfile().reset();
+        resetInlineProfiles(it->second);
+    }
+}
+
+void ExecutorVector::resetProfiles() {
+    typedef std::map<int, std::vector<AbstractExecutor*>*>::value_type MapEntry;
+    BOOST_FOREACH (MapEntry &entry, m_subplanExecListMap) {
+        BOOST_FOREACH (AbstractExecutor* executor, *entry.second) {
+            executor->getProfile().reset();
+            resetInlineProfiles(executor->getPlanNode());
+        }
+    }
+}
+
+enum ProfileColumn {
+    PROFILE_SUBPLAN_ID,
+    PROFILE_PLAN_NODE_ID,
+    PROFILE_PLAN_NODE_TYPE,
+    PROFILE_INLINED_IN,
+    PROFILE_EXECUTION_MICROS,
+    PROFILE_TUPLES_IN,
+    PROFILE_TUPLES_OUT,
+    PROFILE_TEMP_TABLE_PEAK_BYTES,
+    PROFILE_INDEX_PROBES,
+    PROFILE_PREDICATE_EVALUATIONS,
+    PROFILE_COLUMN_COUNT
+};
+
+static const int32_t PROFILE_NODE_TYPE_LENGTH = 64;
+
+static TempTable* buildEmptyProfileTable() {
+    std::vector<std::string> names;
+    names.push_back("SUBPLAN_ID");
+    names.push_back("PLAN_NODE_ID");
+    names.push_back("PLAN_NODE_TYPE");
+    names.push_back("INLINED_IN");
+    names.push_back("EXECUTION_MICROS");
+    names.push_back("TUPLES_IN");
+    names.push_back("TUPLES_OUT");
+    names.push_back("TEMP_TABLE_PEAK_BYTES");
+    names.push_back("INDEX_PROBES");
+    names.push_back("PREDICATE_EVALUATIONS");
+    assert(names.size() == PROFILE_COLUMN_COUNT);
+
+    std::vector<ValueType> types(PROFILE_COLUMN_COUNT, VALUE_TYPE_BIGINT);
+    types[PROFILE_SUBPLAN_ID] = VALUE_TYPE_INTEGER;
+    types[PROFILE_PLAN_NODE_ID] = VALUE_TYPE_INTEGER;
+    types[PROFILE_PLAN_NODE_TYPE] = VALUE_TYPE_VARCHAR;
+    types[PROFILE_INLINED_IN] = VALUE_TYPE_INTEGER;
+    std::vector<int32_t> sizes;
+    BOOST_FOREACH (ValueType type, types) {
+        sizes.push_back(type == VALUE_TYPE_VARCHAR ?
+                        PROFILE_NODE_TYPE_LENGTH : NValue::getTupleStorageSize(type));
+    }
+    // Inline nodes have no measurements of their own, and leaves have no input.
+    std::vector<bool> allowNull(PROFILE_COLUMN_COUNT, true);
+    allowNull[PROFILE_SUBPLAN_ID] = false;
+    allowNull[PROFILE_PLAN_NODE_ID] = false;
+    allowNull[PROFILE_PLAN_NODE_TYPE] = false;
+    std::vector<bool> inBytes(PROFILE_COLUMN_COUNT, false);
+
+    TupleSchema* schema = TupleSchema::createTupleSchema(types, sizes, allowNull, inBytes);
+    return TableFactory::buildTempTable("EXECUTOR_PROFILE", schema, names, NULL);
+}
+
+static void insertProfileRow(TempTable* table, int subplanId,
+                             AbstractPlanNode* node, AbstractPlanNode* host) {
+    TableTuple row = table->tempTuple();
+    row.setNValue(PROFILE_SUBPLAN_ID, ValueFactory::getIntegerValue(subplanId));
+    row.setNValue(PROFILE_PLAN_NODE_ID, ValueFactory::getIntegerValue(node->getPlanNodeId()));
+    row.setNValue(PROFILE_PLAN_NODE_TYPE,
+                  ValueFactory::getTempStringValue(planNodeToString(node->getPlanNodeType())));
+    if (host != NULL) {
+        row.setNValue(PROFILE_INLINED_IN, ValueFactory::getIntegerValue(host->getPlanNodeId()));
+        for (int col = PROFILE_EXECUTION_MICROS; col < PROFILE_COLUMN_COUNT; ++col) {
+            row.setNValue(col, NValue::getNullValue(VALUE_TYPE_BIGINT));
+        }
+        table->insertTempTuple(row);
+        return;
+    }
+
+    const ExecutorProfile& profile = node->getExecutor()->getProfile();
+    row.setNValue(PROFILE_INLINED_IN, NValue::getNullValue(VALUE_TYPE_INTEGER));
+    row.setNValue(PROFILE_EXECUTION_MICROS, ValueFactory::getBigIntValue(profile.m_executionMicros));
+    const std::vector<AbstractPlanNode*>& children = node->getChildren();
+    if (children.empty()) {
+        row.setNValue(PROFILE_TUPLES_IN, NValue::getNullValue(VALUE_TYPE_BIGINT));
+    }
+    else {
+        int64_t tuplesIn = 0;
+        BOOST_FOREACH (AbstractPlanNode* child, children) {
+            tuplesIn += child->getExecutor()->getProfile().m_tuplesOut;
+        }
+        row.setNValue(PROFILE_TUPLES_IN, ValueFactory::getBigIntValue(tuplesIn));
+    }
+    row.setNValue(PROFILE_TUPLES_OUT, ValueFactory::getBigIntValue(profile.m_tuplesOut));
+    row.setNValue(PROFILE_TEMP_TABLE_PEAK_BYTES,
+                  ValueFactory::getBigIntValue(profile.m_peakTempTableMemory));
+    row.setNValue(PROFILE_INDEX_PROBES, ValueFactory::getBigIntValue(profile.m_indexProbes));
+    row.setNValue(PROFILE_PREDICATE_EVALUATIONS,
+                  ValueFactory::getBigIntValue(profile.m_predicateEvaluations));
+    table->insertTempTuple(row);
+}
+
+static void insertInlineProfileRows(TempTable* table, int subplanId, AbstractPlanNode* host) {
+    std::map<PlanNodeType, AbstractPlanNode*>::const_iterator it;
+    for (it = host->getInlinePlanNodes().begin(); it != host->getInlinePlanNodes().end(); ++it) {
+        insertProfileRow(table, subplanId, it->second, host);
+        insertInlineProfileRows(table, subplanId, it->second);
+    }
+}
+
+TempTable* ExecutorVector::buildProfileTable() const {
+    TempTable* table = buildEmptyProfileTable();
+    std::map<int, std::vector<AbstractExecutor*>* >::const_iterator it;
+    for (it = m_subplanExecListMap.begin(); it != m_subplanExecListMap.end(); ++it) {
+        BOOST_FOREACH (AbstractExecutor* executor, *it->second) {
+            AbstractPlanNode* node = executor->getPlanNode();
+            insertProfileRow(table, it->first, node, NULL);
+            insertInlineProfileRows(table, it->first, node);
+        }
+    }
+    return table;
+}
+
 const std::vector<AbstractExecutor*>& ExecutorVector::getExecutorList(int planId) {
     assert(m_subplanExecListMap.find(planId) != m_subplanExecListMap.end());
     return *(m_subplanExecListMap.find(planId)->second);
@@ -63,6 +63,7 @@ class VoltDBEngine;
 class AbstractPlanNode;
 class AbstractExecutor;
 class ExecutorContext;
+class TempTable;
 
 /**
  * A list of executors for runtime.
@@ -94,6 +95,18 @@ public:
 
     void resetLimitStats();
 
+    /** Zero the runtime profile of every executor, inline ones included. */
+    void resetProfiles();
+
+    /**
+     * Build a table with one row per executor describing its last run:
+     * time, tuples in and out, peak temp table memory, index probes and
+     * predicate evaluations. Inline nodes follow their host node, with
+     * their host's id in INLINED_IN and no measurements of their own.
+     * The caller owns the returned table.
+     */
+    TempTable* buildProfileTable() const;
+
     // Get the executors list for a given subplan. The default plan id = 0
     // represents the top level parent plan
     const std::vector<AbstractExecutor*>& getExecutorList(int planId = 0);
@@ -129,6 +142,8 @@ private:
 
     void initPlanNode(VoltDBEngine* engine, AbstractPlanNode* node);
 
+    void setupPipelines(const std::vector<AbstractExecutor*>& executorList);
+
     const int64_t m_fragId;
     std::map<int, std::vector<AbstractExecutor*>* > m_subplanExecListMap;
     TempTableLimits m_limits;
@@ -106,6 +106,8 @@ ENABLE_BOOST_FOREACH_ON_CONST_MAP(MaterializedViewInfo);
 ENABLE_BOOST_FOREACH_ON_CONST_MAP(Table);
 
 static const size_t PLAN_CACHE_SIZE = 1000;
+// how many of the cached plans may be ones that have been reused
+static const size_t PROTECTED_PLAN_CACHE_SIZE = PLAN_CACHE_SIZE * 4 / 5;
 // how many initial tuples to scan before calling into java
 const int64_t LONG_OP_THRESHOLD = 10000;
 // table name prefix of DR conflict table
@@ -135,8 +137,58 @@ typedef boost::multi_index::multi_index_container<
     >
 > PlanSet;
 
-/// This class wrapper around a typedef allows forward declaration as in scoped_ptr<EnginePlanSet>.
-class EnginePlanSet : public PlanSet { };
+/**
+ * The engine's cache of executor vectors, split in two so that a stream of
+ * one-off ad hoc plans cannot push out the plans that keep getting reused.
+ * A newly loaded plan goes into the probationary set and moves to the
+ * protected set the next time it is asked for.  Plans are evicted from the
+ * probationary set first; when the protected set overflows its least recently
+ * used plan is given one more chance at the head of the probationary set.
+ * Both sets are kept in MRU-first order.
+ */
+class EnginePlanSet {
+public:
+    /// Find a cached plan, counting this as a use of it.
+    ExecutorVector* find(int64_t fragId) {
+        PlanSet::nth_index<1>::type::iterator iter = m_protected.get<1>().find(fragId);
+        if (iter != m_protected.get<1>().end()) {
+            m_protected.relocate(m_protected.begin(), m_protected.project<0>(iter));
+            return iter->get();
+        }
+        iter = m_probation.get<1>().find(fragId);
+        if (iter == m_probation.get<1>().end()) {
+            return NULL;
+        }
+        boost::shared_ptr<ExecutorVector> ev_guard = *iter;
+        m_probation.get<1>().erase(iter);
+        m_protected.push_front(ev_guard);
+        if (m_protected.size() > PROTECTED_PLAN_CACHE_SIZE) {
+            m_probation.push_front(m_protected.back());
+            m_protected.pop_back();
+        }
+        return ev_guard.get();
+    }
+
+    /// Cache a newly loaded plan, evicting the least valuable one if the cache is full.
+    void add(boost::shared_ptr<ExecutorVector> ev_guard) {
+        m_probation.push_front(ev_guard);
+        if (m_probation.size() + m_protected.size() > PLAN_CACHE_SIZE) {
+            m_probation.pop_back();
+        }
+    }
+
+    void clear() {
+        m_probation.clear();
+        m_protected.clear();
+    }
+
+    const PlanSet& protectedPlans() const { return m_protected; }
+    const PlanSet& probationaryPlans() const { return m_probation; }
+
+private:
+    PlanSet m_protected;
+    PlanSet m_probation;
+};
 
 VoltDBEngine::VoltDBEngine(Topend *topend, LogProxy *logProxy)
     : m_currentIndexInBatch(0),
@@ -150,6 +202,7 @@ VoltDBEngine::VoltDBEngine(Topend *topend, LogProxy *logProxy)
       m_partitionId(-1),
       m_hashinator(NULL),
       m_isActiveActiveDREnabled(false),
+      m_profilingExecutors(false),
       m_staticParams(MAX_PARAM_COUNT),
       m_pfCount(0),
       m_currentInputDepId(-1),
@@ -477,6 +530,9 @@ int VoltDBEngine::executePlanFragment(int64_t planfragmentId,
     try {
         setExecutorVectorForFragmentId(planfragmentId);
         assert(m_currExecutorVec);
+        if (m_profilingExecutors) {
+            m_currExecutorVec->resetProfiles();
+        }
         // Launch the target plan through its top-most executor list.
         m_executorContext->executeExecutors(0);
         m_executorContext->cleanupAllExecutors();
@@ -488,6 +544,10 @@ int VoltDBEngine::executePlanFragment(int64_t planfragmentId,
     }
 
     int64_t tuplesModified = m_tuplesModifiedStack.top();
+    boost::scoped_ptr<TempTable> profile;
+    if (m_profilingExecutors) {
+        profile.reset(m_currExecutorVec->buildProfileTable());
+    }
     resetExecutionMetadata();
 
     // assume this is sendless dml
@@ -499,6 +559,11 @@ int VoltDBEngine::executePlanFragment(int64_t planfragmentId,
         m_numResultDependencies++;
     }
 
+    // The profile follows the fragment's own results.
+    if (profile) {
+        send(profile.get());
+    }
+
     //Write the number of result dependencies if necessary.
     m_resultOutput.writeIntAt(numResultDependenciesCountOffset, m_numResultDependencies);
 
@@ -897,12 +962,21 @@ VoltDBEngine::processCatalogAdditions(int64_t timestamp)
 
             PersistentTable *persistentTable = tcd->getPersistentTable();
             //////////////////////////////////////////
-            // if the table schema has changed, build a new
-            // table and migrate tuples over to it, repopulating
-            // indexes as we go
+            // if the table schema has changed but keeps the
+            // tuple format, update it in place. Otherwise build
+            // a new table and migrate tuples over to it,
+            // repopulating indexes as we go
             //////////////////////////////////////////
 
-            if (haveDifferentSchema(catalogTable, persistentTable)) {
+            bool schemaChanged = haveDifferentSchema(catalogTable, persistentTable);
+            if (schemaChanged && tcd->relaxSchemaInPlace(*m_database, *catalogTable)) {
+                char msg[512];
+                snprintf(msg, sizeof(msg), "Table %s has changed schema in place.",
+                         catalogTable->name().c_str());
+                LogManager::getThreadLogger(LOGGERID_HOST)->log(LOGLEVEL_DEBUG, msg);
+                // fall through to modify/add/remove indexes and views
+            }
+            else if (schemaChanged) {
                 char msg[512];
                 snprintf(msg, sizeof(msg), "Table %s has changed schema and will be rebuilt.",
                          catalogTable->name().c_str());
@@ -1260,15 +1334,9 @@ void VoltDBEngine::resetDRConflictStreamedTables()
 void VoltDBEngine::setExecutorVectorForFragmentId(int64_t fragId)
 {
     if (m_plans) {
-        PlanSet& existing_plans = *m_plans;
-        PlanSet::nth_index<1>::type::iterator iter = existing_plans.get<1>().find(fragId);
-
-        // found it, move it to the front
-        if (iter != existing_plans.get<1>().end()) {
-            // move it to the front of the list
-            PlanSet::iterator iter2 = existing_plans.project<0>(iter);
-            existing_plans.get<0>().relocate(existing_plans.begin(), iter2);
-            m_currExecutorVec = (*iter).get();
+        ExecutorVector* cached = m_plans->find(fragId);
+        if (cached) {
+            m_currExecutorVec = cached;
             // update the context
             m_currExecutorVec->setupContext(m_executorContext);
             return;
@@ -1278,7 +1346,6 @@ void VoltDBEngine::setExecutorVectorForFragmentId(int64_t fragId)
         m_plans.reset(new EnginePlanSet());
     }
 
-    PlanSet& plans = *m_plans;
     std::string plan = m_topend->planForFragmentId(fragId);
     if (plan.length() == 0) {
         char msg[1024];
@@ -1290,17 +1357,9 @@ void VoltDBEngine::setExecutorVectorForFragmentId(int64_t fragId)
 
     boost::shared_ptr<ExecutorVector> ev_guard = ExecutorVector::fromJsonPlan(this, plan, fragId);
 
-    // add the plan to the back
-    //
-    // (Why to the back?  Shouldn't it be at the front with the
-    // most recently used items?  See ENG-7244)
-    plans.get<0>().push_back(ev_guard);
-
-    // remove a plan from the front if the cache is full
-    if (plans.size() > PLAN_CACHE_SIZE) {
-        PlanSet::iterator iter = plans.get<0>().begin();
-        plans.erase(iter);
-    }
+    // The new plan is never the one evicted here, since the eviction
+    // comes off the least recently used end.
+    m_plans->add(ev_guard);
 
     m_currExecutorVec = ev_guard.get();
     assert(m_currExecutorVec);
@@ -1493,10 +1552,12 @@ std::string VoltDBEngine::debug(void) const
     if ( ! m_plans) {
         return "";
     }
-    PlanSet& plans = *m_plans;
     std::ostringstream output;
 
-    BOOST_FOREACH (boost::shared_ptr<ExecutorVector> ev_guard, plans) {
+    BOOST_FOREACH (boost::shared_ptr<ExecutorVector> ev_guard, m_plans->protectedPlans()) {
+        ev_guard->debug();
+    }
+    BOOST_FOREACH (boost::shared_ptr<ExecutorVector> ev_guard, m_plans->probationaryPlans()) {
         ev_guard->debug();
     }
 
@@ -1999,6 +2060,11 @@ void VoltDBEngine::executeTask(TaskType taskType, ReferenceSerializeInputBE &tas
         m_resultOutput.writeInt(0);
         break;
     }
+    case TASK_TYPE_SET_EXECUTOR_PROFILING: {
+        setExecutorProfiling(taskInfo.readByte() != 0);
+        m_resultOutput.writeInt(0);
+        break;
+    }
     case TASK_TYPE_GENERATE_DR_EVENT: {
         // we start using in-band CATALOG_UPDATE at version 5
         if (m_drVersion >= 5) {
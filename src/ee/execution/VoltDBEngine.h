@@ -415,6 +415,18 @@ class __attribute__((visibility("default"))) VoltDBEngine {
             return m_partitionId;
         }
 
+        /**
+         * While on, every plan fragment returns one more result table after
+         * its own, with a row of timings and counts for each of its executors.
+         */
+        void setExecutorProfiling(bool enabled) {
+            m_profilingExecutors = enabled;
+        }
+
+        bool isProfilingExecutors() const {
+            return m_profilingExecutors;
+        }
+
     protected:
         void setHashinator(TheHashinator* hashinator);
 
@@ -529,6 +541,7 @@ class __attribute__((visibility("default"))) VoltDBEngine {
         boost::scoped_ptr<catalog::Catalog> m_catalog;
         catalog::Database *m_database;
         bool m_isActiveActiveDREnabled;
+        bool m_profilingExecutors;
 
         /** reused parameter container. */
         NValueArray m_staticParams;
@@ -52,6 +52,7 @@
 #include "storage/tablefactory.h"
 #include "storage/TableCatalogDelegate.hpp"
 
+#include <sys/time.h>
 #include <vector>
 
 using namespace std;
@@ -127,6 +128,8 @@ bool AbstractExecutor::init(VoltDBEngine* engine,
         }
     }
 
+    m_limits = limits;
+
     // Call the p_init() method on our derived class
     if (!p_init(m_abstractNode, limits)) {
         return false;
@@ -139,6 +142,48 @@ bool AbstractExecutor::init(VoltDBEngine* engine,
     return true;
 }
 
+static int64_t outputTupleCount(const TempTable* table)
+{
+    if (table == NULL) {
+        return 0;
+    }
+    return table->tempTableTupleCount() + table->pipelinedTupleCount();
+}
+
+void AbstractExecutor::markProfiledOutput()
+{
+    // Output tables are emptied between the runs of a subquery,
+    // so count what each run adds to them.
+    m_profiledOutputMark = outputTupleCount(m_tmpOutputTable);
+}
+
+bool AbstractExecutor::executeWithProfile(const NValueArray& params)
+{
+    int64_t outerPeak = 0;
+    if (m_limits) {
+        outerPeak = m_limits->markPeakMemory();
+    }
+    struct timeval start;
+    gettimeofday(&start, NULL);
+
+    bool result = execute(params);
+
+    struct timeval end;
+    gettimeofday(&end, NULL);
+    m_profile.m_executionMicros += (end.tv_sec - start.tv_sec) * 1000000LL +
+                                   (end.tv_usec - start.tv_usec);
+    m_profile.m_tuplesOut += outputTupleCount(m_tmpOutputTable) - m_profiledOutputMark;
+    if (m_limits) {
+        int64_t peak = m_limits->getPeakMemorySinceMark();
+        if (peak > m_profile.m_peakTempTableMemory) {
+            m_profile.m_peakTempTableMemory = peak;
+        }
+        // An executor that runs this one as a subquery keeps its own mark.
+        m_limits->restorePeakMemoryMark(outerPeak);
+    }
+    return result;
+}
+
 /**
  * Set up a multi-column temp output table for those executors that require one.
  * Called from p_init.
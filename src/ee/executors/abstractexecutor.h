@@ -62,6 +62,33 @@ class AbstractExpression;
 class TempTableLimits;
 class VoltDBEngine;
 
+/**
+ * What an executor did in the current run of its fragment, collected when
+ * the engine is profiling executors. Executors run once per outer row in
+ * a subquery add up across those runs. The time and tuple counts of an
+ * inline node belong to the node that hosts it; index probes and predicate
+ * evaluations are counted by whichever executor does them.
+ */
+struct ExecutorProfile {
+    ExecutorProfile() { reset(); }
+
+    void reset() {
+        m_executionMicros = 0;
+        m_tuplesOut = 0;
+        m_peakTempTableMemory = 0;
+        m_indexProbes = 0;
+        m_predicateEvaluations = 0;
+    }
+
+    /** Wall time, including that of any subqueries run along the way. */
+    int64_t m_executionMicros;
+    int64_t m_tuplesOut;
+    /** Most temp table memory held by the fragment while this executor ran. */
+    int64_t m_peakTempTableMemory;
+    int64_t m_indexProbes;
+    int64_t m_predicateEvaluations;
+};
+
 /**
  * AbstractExecutor provides the API for initializing and invoking executors.
  */
@@ -75,6 +102,18 @@ class AbstractExecutor {
     /** Invoke a plannode's associated executor */
     bool execute(const NValueArray& params);
 
+    /**
+     * Note how many tuples the executor has output so far, before a profiled
+     * run of its executor list. This comes first because children may push
+     * tuples into a pipelined parent before the parent itself executes.
+     */
+    void markProfiledOutput();
+
+    /** Invoke the executor, timing it and counting its output into its profile */
+    bool executeWithProfile(const NValueArray& params);
+
+    ExecutorProfile& getProfile() { return m_profile; }
+
     /**
      * Returns the plannode that generated this executor.
      */
@@ -100,6 +139,27 @@ class AbstractExecutor {
         // LEAVE as blank on purpose
     }
 
+    /**
+     * Executors that can consume their input one tuple at a time as their
+     * children produce it return the sink to push those tuples to.
+     * See ExecutorVector::setupPipelines.
+     */
+    virtual TempTableTupleSink* getPipelinedInputSink() { return NULL; }
+
+    /**
+     * Set up per-execution state of an executor whose input is pipelined.
+     * This runs before any executor in the list, as its children push
+     * tuples into it before its own turn to execute comes.
+     */
+    virtual void startPipelinedInput(const NValueArray& params) { }
+
+    void setPipelinedInput() { m_pipelinedInput = true; }
+
+    bool hasPipelinedInput() const { return m_pipelinedInput; }
+
+    /** The temp table this executor writes its output to, if any. */
+    TempTable* getTempOutputTable() const { return m_tmpOutputTable; }
+
     inline bool outputTempTableIsEmpty() const {
         if (m_tmpOutputTable != NULL) {
             return m_tmpOutputTable->activeTupleCount() == 0;
@@ -127,6 +187,9 @@ class AbstractExecutor {
         m_abstractNode = abstractNode;
         m_tmpOutputTable = NULL;
         m_engine = engine;
+        m_pipelinedInput = false;
+        m_limits = NULL;
+        m_profiledOutputMark = 0;
     }
 
     /** Concrete executor classes implement initialization in p_init() */
@@ -155,6 +218,15 @@ class AbstractExecutor {
     /** reference to the engine to call up to the top end */
     VoltDBEngine* m_engine;
 
+    /** whether the children push their output tuples to this executor */
+    bool m_pipelinedInput;
+
+    /** the temp table memory accounting of the executor's fragment */
+    TempTableLimits* m_limits;
+
+    ExecutorProfile m_profile;
+    int64_t m_profiledOutputMark;
+
 };
 
 
@@ -113,6 +113,9 @@ bool DeleteExecutor::p_execute(const NValueArray &params) {
         assert(m_inputTable);
         assert(m_inputTuple.sizeInValues() == m_inputTable->columnCount());
         assert(targetTuple.sizeInValues() == targetTable->columnCount());
+        // Views on the target are brought up to date once per group
+        // after all the rows are gone rather than once per row.
+        ScopedDeferredViewUpdates deferredViewUpdates(targetTable);
         TableIterator inputIterator = m_inputTable->iterator();
         while (inputIterator.next(m_inputTuple)) {
             //
@@ -128,6 +131,7 @@ bool DeleteExecutor::p_execute(const NValueArray &params) {
             // Delete from target table
             targetTable->deleteTuple(targetTuple, true);
         }
+        deferredViewUpdates.apply();
         modified_tuples = m_inputTable->tempTableTupleCount();
         VOLT_TRACE("Deleted %d rows from table : %s with %d active, %d visible, %d allocated",
                    (int)modified_tuples,
@@ -45,6 +45,11 @@
 
 #include "executorutil.h"
 
+#include "expressions/tuplevalueexpression.h"
+#include "plannodes/abstractplannode.h"
+#include "plannodes/projectionnode.h"
+#include "storage/tableiterator.h"
+
 namespace voltdb {
 
 CountingPostfilter::CountingPostfilter(const TempTable* table, const AbstractExpression * postPredicate, int limit, int offset,
@@ -55,7 +60,8 @@ CountingPostfilter::CountingPostfilter(const TempTable* table, const AbstractExp
     m_limit(limit),
     m_offset(offset),
     m_tuple_skipped(0),
-    m_under_limit(true)
+    m_under_limit(true),
+    m_evaluations(0)
 {}
 
 
@@ -66,7 +72,70 @@ CountingPostfilter::CountingPostfilter() :
     m_limit(NO_LIMIT),
     m_offset(NO_OFFSET),
     m_tuple_skipped(0),
-    m_under_limit(false)
+    m_under_limit(false),
+    m_evaluations(0)
 {}
 
+static bool hashesByValue(ValueType type) {
+    switch (type) {
+    case VALUE_TYPE_TINYINT:
+    case VALUE_TYPE_SMALLINT:
+    case VALUE_TYPE_INTEGER:
+    case VALUE_TYPE_BIGINT:
+    case VALUE_TYPE_TIMESTAMP:
+    case VALUE_TYPE_DECIMAL:
+    case VALUE_TYPE_VARCHAR:
+    case VALUE_TYPE_VARBINARY:
+        return true;
+    default:
+        // Floating point values that compare equal, like 0.0 and -0.0,
+        // may hash apart, and the geospatial types don't compare by value.
+        return false;
+    }
+}
+
+void SemiJoinFilter::init(const AbstractPlanNode* source,
+                          const std::vector<int>& sourceColumns,
+                          const std::vector<int>& outputColumns,
+                          const TupleSchema* inputSchema,
+                          const ProjectionPlanNode* projection) {
+    assert(sourceColumns.size() == outputColumns.size());
+    m_source = NULL;
+    m_sourceColumns.clear();
+    m_inputColumns.clear();
+    for (std::size_t ii = 0; ii < outputColumns.size(); ++ii) {
+        int inputColumn = outputColumns[ii];
+        if (projection != NULL) {
+            const AbstractExpression* expression = projection->getOutputColumnExpressions()[inputColumn];
+            if (expression->getExpressionType() != EXPRESSION_TYPE_VALUE_TUPLE) {
+                continue;
+            }
+            inputColumn = static_cast<const TupleValueExpression*>(expression)->getColumnId();
+        }
+        const ValueType type = source->getOutputTable()->schema()->columnType(sourceColumns[ii]);
+        if (type != inputSchema->columnType(inputColumn) || ! hashesByValue(type)) {
+            continue;
+        }
+        m_sourceColumns.push_back(sourceColumns[ii]);
+        m_inputColumns.push_back(inputColumn);
+    }
+    if ( ! m_inputColumns.empty()) {
+        m_source = source;
+    }
+}
+
+void SemiJoinFilter::load() {
+    assert(m_source);
+    Table* source = m_source->getOutputTable();
+    m_filter.reset(static_cast<std::size_t>(source->activeTupleCount()));
+    TableTuple tuple(source->schema());
+    TableIterator iterator = source->iterator();
+    while (iterator.next(tuple)) {
+        std::size_t hash;
+        if (keyHash(tuple, m_sourceColumns, hash)) {
+            m_filter.insert(hash);
+        }
+    }
+}
+
 }
@@ -49,12 +49,17 @@
 #include "common/tabletuple.h"
 #include "expressions/abstractexpression.h"
 #include "storage/temptable.h"
+#include "structures/BlockedBloomFilter.h"
 
 #include <cstddef> // for NULL !
 #include <cassert>
+#include <vector>
 
 namespace voltdb {
 
+class AbstractPlanNode;
+class ProjectionPlanNode;
+
 // Helper struct to evaluate a postfilter and count the number of tuples that
 // successfully passed the evaluation
 struct CountingPostfilter {
@@ -77,6 +82,11 @@ struct CountingPostfilter {
     // Returns true if predicate evaluates to true and LIMIT/OFFSET conditions are satisfied.
     bool eval(const TableTuple* outer_tuple, const TableTuple* inner_tuple);
 
+    // Returns the number of times the predicate has been evaluated
+    int64_t evaluationCount() const {
+        return m_evaluations;
+    }
+
     private:
 
     // Indicate that an inline (child) AggCountingPostfilter associated with this postfilter
@@ -94,10 +104,14 @@ struct CountingPostfilter {
 
     int m_tuple_skipped;
     bool m_under_limit;
+    int64_t m_evaluations;
 };
 
 inline
 bool CountingPostfilter::eval(const TableTuple* outer_tuple, const TableTuple* inner_tuple) {
+    if (m_postPredicate != NULL) {
+        ++m_evaluations;
+    }
     if (m_postPredicate == NULL || m_postPredicate->eval(outer_tuple, inner_tuple).isTrue()) {
         // Check if we have to skip this tuple because of offset
         if (m_tuple_skipped < m_offset) {
@@ -123,6 +137,66 @@ bool CountingPostfilter::eval(const TableTuple* outer_tuple, const TableTuple* i
     return false;
 }
 
+/**
+ * Lets a scan that feeds the inner side of an equi-join drop, before
+ * evaluating its predicate or projecting them, the tuples whose join key
+ * no tuple of the outer table has, since the join can't match them. The
+ * keys of the outer table, the output of the plan node that feeds the
+ * outer side, are loaded into a blocked Bloom filter at the start of each
+ * execution, so a few tuples without a partner still get through, to be
+ * rejected by the join itself.
+ */
+class SemiJoinFilter {
+public:
+    SemiJoinFilter() : m_source(NULL) { }
+
+    /**
+     * Filter on the key made of the given output columns of the scan,
+     * paired with the given columns of the output table of the source
+     * node. A pair is left out when the output column is not a copy of
+     * an input column, when the two columns differ in type, or when
+     * equal values of their type may hash apart. The filter stays
+     * inactive if no pair is left.
+     */
+    void init(const AbstractPlanNode* source,
+              const std::vector<int>& sourceColumns,
+              const std::vector<int>& outputColumns,
+              const TupleSchema* inputSchema,
+              const ProjectionPlanNode* projection);
+
+    bool isActive() const { return m_source != NULL; }
+
+    /** Load the keys the source table holds now. */
+    void load();
+
+    /**
+     * Return false if no tuple of the source table has the key of the
+     * given input tuple of the scan. A null key never matches.
+     */
+    bool mayMatch(const TableTuple& tuple) const {
+        std::size_t hash;
+        return keyHash(tuple, m_inputColumns, hash) && m_filter.mayContain(hash);
+    }
+
+private:
+    static bool keyHash(const TableTuple& tuple, const std::vector<int>& columns, std::size_t& hash) {
+        hash = 0;
+        for (std::size_t ii = 0; ii < columns.size(); ++ii) {
+            const NValue value = tuple.getNValue(columns[ii]);
+            if (value.isNull()) {
+                return false;
+            }
+            value.hashCombine(hash);
+        }
+        return true;
+    }
+
+    const AbstractPlanNode* m_source;
+    std::vector<int> m_sourceColumns;
+    std::vector<int> m_inputColumns;
+    BlockedBloomFilter m_filter;
+};
+
 }
 
 #endif
@@ -372,6 +372,7 @@ bool IndexScanExecutor::p_execute(const NValueArray &params)
     //
 
     TableTuple tuple;
+    ++m_profile.m_indexProbes;
     if (activeNumOfSearchKeys > 0) {
         VOLT_TRACE("INDEX_LOOKUP_TYPE(%d) m_numSearchkeys(%d) key:%s",
                 localLookupType, activeNumOfSearchKeys, searchKey.debugNoHeader().c_str());
@@ -422,6 +423,13 @@ bool IndexScanExecutor::p_execute(const NValueArray &params)
         tableIndex->moveToEnd(toStartActually, indexCursor);
     }
 
+    // Drop up front the tuples that the join this scan feeds would find
+    // no partner for.
+    const bool semiJoinFiltered = m_semiJoinFilter.isActive();
+    if (semiJoinFiltered) {
+        m_semiJoinFilter.load();
+    }
+
     //
     // We have to different nextValue() methods for different lookup types
     //
@@ -455,6 +463,9 @@ bool IndexScanExecutor::p_execute(const NValueArray &params)
             VOLT_TRACE("End Expression evaluated to false, stopping scan");
             break;
         }
+        if (semiJoinFiltered && ! m_semiJoinFilter.mayMatch(tuple)) {
+            continue;
+        }
         //
         // Then apply our post-predicate and LIMIT/OFFSET to do further filtering
         //
@@ -474,12 +485,22 @@ bool IndexScanExecutor::p_execute(const NValueArray &params)
     if (m_aggExec != NULL) {
         m_aggExec->p_execute_finish();
     }
-
+    m_profile.m_predicateEvaluations += postfilter.evaluationCount();
 
     VOLT_DEBUG ("Index Scanned :\n %s", m_outputTable->debug().c_str());
     return true;
 }
 
+void IndexScanExecutor::setSemiJoinFilter(const AbstractPlanNode* source,
+                                          const std::vector<int>& sourceColumns,
+                                          const std::vector<int>& outputColumns) {
+    if (m_aggExec != NULL || m_node->getInlinePlanNode(PLAN_NODE_TYPE_LIMIT) != NULL) {
+        return;
+    }
+    m_semiJoinFilter.init(source, sourceColumns, outputColumns,
+                          m_node->getTargetTable()->schema(), m_projectionNode);
+}
+
 void IndexScanExecutor::outputTuple(CountingPostfilter& postfilter, TableTuple& tuple) {
     if (m_aggExec != NULL) {
         m_aggExec->p_execute_tuple(tuple);
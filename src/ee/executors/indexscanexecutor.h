@@ -48,6 +48,7 @@
 
 #include "common/tabletuple.h"
 #include "executors/abstractexecutor.h"
+#include "executors/executorutil.h"
 #include "executors/OptimizedProjector.hpp"
 #include "indexes/tableindex.h"
 
@@ -69,8 +70,6 @@ class LimitPlanNode;
 
 class AggregateExecutorBase;
 
-struct CountingPostfilter;
-
 class IndexScanExecutor : public AbstractExecutor
 {
 public:
@@ -107,6 +106,16 @@ public:
         return ! tuple->isNullTuple();
     }
 
+    /**
+     * Drop the tuples whose values in the given output columns no output
+     * tuple of the source node has in the paired columns, as the inner
+     * side of an equi-join with it. Ignored by a scan with an inline
+     * LIMIT or aggregate.
+     */
+    void setSemiJoinFilter(const AbstractPlanNode* source,
+                           const std::vector<int>& sourceColumns,
+                           const std::vector<int>& outputColumns);
+
 private:
     bool p_init(AbstractPlanNode*,
                 TempTableLimits* limits);
@@ -133,6 +142,8 @@ private:
     // IndexScan Information
     TempTable* m_outputTable;
 
+    SemiJoinFilter m_semiJoinFilter;
+
     // arrange the memory mgmt aids at the bottom to try to maximize
     // cache hits (by keeping them out of the way of useful runtime data)
     boost::shared_array<int> m_projectionAllTupleArrayPtr;
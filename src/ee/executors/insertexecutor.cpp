@@ -51,6 +51,7 @@
 #include "common/types.h"
 #include "execution/VoltDBEngine.h"
 #include "expressions/functionexpression.h"
+#include "indexes/tableindex.h"
 #include "insertexecutor.h"
 #include "plannodes/insertnode.h"
 #include "storage/ConstraintFailureException.h"
@@ -61,6 +62,9 @@
 #include "storage/tableutil.h"
 #include "storage/temptable.h"
 
+#include <boost/foreach.hpp>
+
+#include <algorithm>
 #include <vector>
 #include <set>
 
@@ -160,6 +164,65 @@ void InsertExecutor::executePurgeFragmentIfNeeded(PersistentTable** ptrToTable)
     }
 }
 
+// The most rows a multi-row insert holds back to sort by primary key.
+static const int INSERT_BATCH_SIZE = 1024;
+
+namespace {
+
+// Orders tuples by their values in the given (primary key) columns.
+struct KeyColumnsLess {
+    KeyColumnsLess(const std::vector<int> &columns) : m_columns(columns) { }
+    bool operator()(const TableTuple &lhs, const TableTuple &rhs) const {
+        BOOST_FOREACH(int column, m_columns) {
+            int cmp = lhs.getNValue(column).compare(rhs.getNValue(column));
+            if (cmp != 0) {
+                return cmp < 0;
+            }
+        }
+        return false;
+    }
+    const std::vector<int> &m_columns;
+};
+
+}
+
+bool InsertExecutor::upsertExistingTuple(PersistentTable* table, TableTuple &tuple) {
+    assert(table->primaryKeyIndex() != NULL);
+    TableTuple existsTuple = table->lookupTupleByValues(tuple);
+    if (existsTuple.isNullTuple()) {
+        return false;
+    }
+    // The tuple exists already, update (only) the tuple columns
+    // that were initialized from the input tuple via the field map.
+    // Technically, this includes setting primary key values,
+    // but they are getting set to equivalent values, so that's OK.
+    // A simple setNValue works here because any required object
+    // allocations were handled when copying the input values into
+    // the tuple.
+    const std::vector<int>& fieldMap = m_node->getFieldMap();
+    TableTuple &tempTuple = table->copyIntoTempTuple(existsTuple);
+    for (int i = 0; i < fieldMap.size(); ++i) {
+        tempTuple.setNValue(fieldMap[i], tuple.getNValue(fieldMap[i]));
+    }
+    table->updateTupleWithSpecificIndexes(existsTuple, tempTuple, table->allIndexes());
+    return true;
+}
+
+int InsertExecutor::applyBatch(PersistentTable* table) {
+    // A stable sort keeps rows with the same key in statement order,
+    // so a later row still upserts (or collides with) an earlier one.
+    std::stable_sort(m_batch.begin(), m_batch.end(),
+                     KeyColumnsLess(table->primaryKeyIndex()->getColumnIndices()));
+    BOOST_FOREACH(TableTuple &tuple, m_batch) {
+        if ( ! m_isUpsert || ! upsertExistingTuple(table, tuple)) {
+            table->insertTuple(tuple);
+        }
+    }
+    int applied = static_cast<int>(m_batch.size());
+    m_batch.clear();
+    return applied;
+}
+
 bool InsertExecutor::p_execute(const NValueArray &params) {
     assert(m_node == dynamic_cast<InsertPlanNode*>(m_abstractNode));
     assert(m_node);
@@ -175,7 +238,6 @@ bool InsertExecutor::p_execute(const NValueArray &params) {
 
     PersistentTable* persistentTable = m_isStreamed ?
         NULL : static_cast<PersistentTable*>(targetTable);
-    TableTuple upsertTuple = TableTuple(targetTable->schema());
 
     VOLT_TRACE("INPUT TABLE: %s\n", m_inputTable->debug().c_str());
 
@@ -225,6 +287,26 @@ bool InsertExecutor::p_execute(const NValueArray &params) {
     Pool* tempPool = ExecutorContext::getTempStringPool();
     const std::vector<int>& fieldMap = m_node->getFieldMap();
     std::size_t mapSize = fieldMap.size();
+    // A purge fragment may swap in a fresh table part way through,
+    // so the views are only caught up at the end when there is none.
+    ScopedDeferredViewUpdates deferredViewUpdates(m_hasPurgeFragment ? NULL : persistentTable);
+
+    // The rows of a multi-row insert into a table with a primary key are
+    // checked for partitioning and copied aside first, then inserted in key
+    // order, so that consecutive index insertions and upsert lookups descend
+    // through the same recently visited part of each index.
+    // A purge fragment may swap in a fresh table part way through, so it rules this out.
+    const int tupleCount = static_cast<int>(m_inputTable->tempTableTupleCount());
+    const bool batched = persistentTable != NULL &&
+                         persistentTable->primaryKeyIndex() != NULL &&
+                         ! m_hasPurgeFragment &&
+                         tupleCount > 1;
+    const int tupleLength = templateTuple.tupleLength();
+    if (batched) {
+        m_batchStorage.resize(static_cast<size_t>(std::min(tupleCount, INSERT_BATCH_SIZE)) * tupleLength);
+        m_batch.reserve(std::min(tupleCount, INSERT_BATCH_SIZE));
+        m_batch.clear();
+    }
     while (iterator.next(inputTuple)) {
 
         for (int i = 0; i < mapSize; ++i) {
@@ -285,36 +367,26 @@ bool InsertExecutor::p_execute(const NValueArray &params) {
             }
         }
 
-        if (m_isUpsert) {
-            // upsert execution logic
-            assert(persistentTable->primaryKeyIndex() != NULL);
-            TableTuple existsTuple = persistentTable->lookupTupleByValues(templateTuple);
-
-            if (!existsTuple.isNullTuple()) {
-                // The tuple exists already, update (only) the templateTuple columns
-                // that were initialized from the input tuple via the field map.
-                // Technically, this includes setting primary key values,
-                // but they are getting set to equivalent values, so that's OK.
-                // A simple setNValue works here because any required object
-                // allocations were handled when copying the input values into
-                // the templateTuple.
-                upsertTuple.move(templateTuple.address());
-                TableTuple &tempTuple = persistentTable->copyIntoTempTuple(existsTuple);
-                for (int i = 0; i < mapSize; ++i) {
-                    tempTuple.setNValue(fieldMap[i],
-                                        templateTuple.getNValue(fieldMap[i]));
-                }
-
-                persistentTable->updateTupleWithSpecificIndexes(existsTuple, tempTuple,
-                                                                persistentTable->allIndexes());
-                // successfully updated
-                ++modifiedTuples;
-                continue;
+        if (batched) {
+            // Any object values of the copy stay in the temp string pool
+            // until the end of the fragment.
+            char *batchData = &m_batchStorage[m_batch.size() * tupleLength];
+            ::memcpy(batchData, templateTuple.address(), tupleLength);
+            m_batch.push_back(TableTuple(batchData, templateTuple.getSchema()));
+            if (m_batch.size() == INSERT_BATCH_SIZE) {
+                modifiedTuples += applyBatch(persistentTable);
             }
-            // else, the primary key did not match,
-            // so fall through to the "insert" logic
+            continue;
         }
 
+        if (m_isUpsert && upsertExistingTuple(persistentTable, templateTuple)) {
+            // successfully updated
+            ++modifiedTuples;
+            continue;
+        }
+        // else, the primary key did not match (or this is no upsert),
+        // so fall through to the "insert" logic
+
         // try to put the tuple into the target table
         if (m_hasPurgeFragment) {
             executePurgeFragmentIfNeeded(&persistentTable);
@@ -327,6 +399,10 @@ bool InsertExecutor::p_execute(const NValueArray &params) {
         // successfully inserted
         ++modifiedTuples;
     }
+    if (batched) {
+        modifiedTuples += applyBatch(persistentTable);
+    }
+    deferredViewUpdates.apply();
 
     count_tuple.setNValue(0, ValueFactory::getBigIntValue(modifiedTuples));
     // put the tuple into the output table
@@ -52,6 +52,8 @@
 #include "common/valuevector.h"
 #include "executors/abstractexecutor.h"
 
+#include <vector>
+
 namespace voltdb {
 
 class InsertPlanNode;
@@ -75,7 +77,9 @@ public:
         m_hasPurgeFragment(false),
         m_templateTuple(),
         m_memoryPool(),
-        m_nowFields()
+        m_nowFields(),
+        m_batchStorage(),
+        m_batch()
     {
     }
 
@@ -109,6 +113,17 @@ public:
          */
         void executePurgeFragmentIfNeeded(PersistentTable** table);
 
+        /** For an upsert, update the row with the tuple's primary key
+         * from the tuple, if there is one.  Returns false if there is
+         * none and the tuple needs to be inserted instead.
+         */
+        bool upsertExistingTuple(PersistentTable* table, TableTuple &tuple);
+
+        /** Insert (or upsert) the batched tuples in primary key order
+         * and empty the batch.  Returns the number of tuples applied.
+         */
+        int applyBatch(PersistentTable* table);
+
         /** A tuple with the target table's schema that is populated
          * with default values for each field. */
         StandAloneTupleStorage m_templateTuple;
@@ -121,6 +136,12 @@ public:
          * that has a DEFAULT of NOW, which must be set on each
          * execution of this plan. */
         std::vector<int> m_nowFields;
+
+        /** Storage for the tuples of a multi-row insert that are
+         * waiting to be applied in primary key order, and the tuples
+         * themselves. */
+        std::vector<char> m_batchStorage;
+        std::vector<TableTuple> m_batch;
 };
 
 }
@@ -82,11 +82,51 @@ LimitExecutor::p_init(AbstractPlanNode* abstract_node,
     return true;
 }
 
+TempTableTupleSink*
+LimitExecutor::getPipelinedInputSink()
+{
+    if (m_abstractNode->isInline()) {
+        return NULL;
+    }
+    return this;
+}
+
+void
+LimitExecutor::startPipelinedInput(const NValueArray &params)
+{
+    LimitPlanNode* node = dynamic_cast<LimitPlanNode*>(m_abstractNode);
+    assert(node);
+    m_pipelinedLimit = -1;
+    m_pipelinedOffset = -1;
+    node->getLimitAndOffsetByReference(params, m_pipelinedLimit, m_pipelinedOffset);
+    m_pipelinedTupleCount = 0;
+    m_pipelinedTuplesSkipped = 0;
+}
+
+void
+LimitExecutor::pushTuple(TableTuple &tuple)
+{
+    // The child can not be stopped early, so just drop what is past the limit.
+    if (m_pipelinedLimit != -1 && m_pipelinedTupleCount >= m_pipelinedLimit) {
+        return;
+    }
+    if (m_pipelinedTuplesSkipped < m_pipelinedOffset) {
+        m_pipelinedTuplesSkipped++;
+        return;
+    }
+    m_pipelinedTupleCount++;
+    m_abstractNode->getOutputTable()->insertTuple(tuple);
+}
+
 bool
 LimitExecutor::p_execute(const NValueArray &params)
 {
     LimitPlanNode* node = dynamic_cast<LimitPlanNode*>(m_abstractNode);
     assert(node);
+    if (m_pipelinedInput) {
+        // The child has already pushed every tuple through pushTuple.
+        return true;
+    }
     Table* output_table = node->getOutputTable();
     assert(output_table);
     Table* input_table = node->getInputTable();
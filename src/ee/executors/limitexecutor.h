@@ -53,21 +53,36 @@ namespace voltdb
     /**
      *
      */
-    class LimitExecutor : public AbstractExecutor
+    class LimitExecutor : public AbstractExecutor, public TempTableTupleSink
     {
     public:
         LimitExecutor(VoltDBEngine* engine, AbstractPlanNode* abstract_node)
             : AbstractExecutor(engine, abstract_node)
+            , m_pipelinedLimit(-1)
+            , m_pipelinedOffset(-1)
+            , m_pipelinedTupleCount(0)
+            , m_pipelinedTuplesSkipped(0)
         {
         }
 
         ~LimitExecutor() {
         }
 
+        TempTableTupleSink* getPipelinedInputSink();
+        void startPipelinedInput(const NValueArray &params);
+        void pushTuple(TableTuple &tuple);
+
     private:
         bool p_init(AbstractPlanNode*,
                     TempTableLimits* limits);
         bool p_execute(const NValueArray &params);
+
+        // LIMIT and OFFSET state of the current execution,
+        // when the input is pipelined
+        int m_pipelinedLimit;
+        int m_pipelinedOffset;
+        int m_pipelinedTupleCount;
+        int m_pipelinedTuplesSkipped;
     };
 
 }
@@ -50,6 +50,8 @@
 #include "common/FatalException.hpp"
 #include "executors/aggregateexecutor.h"
 #include "executors/executorutil.h"
+#include "executors/indexscanexecutor.h"
+#include "executors/seqscanexecutor.h"
 #include "execution/ProgressMonitorProxy.h"
 #include "expressions/abstractexpression.h"
 #include "expressions/tuplevalueexpression.h"
@@ -61,6 +63,7 @@
 #include "plannodes/limitnode.h"
 #include "plannodes/aggregatenode.h"
 
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <stack>
@@ -77,6 +80,38 @@ using namespace voltdb;
 const static int8_t UNMATCHED_TUPLE(TableTupleFilter::ACTIVE_TUPLE);
 const static int8_t MATCHED_TUPLE(TableTupleFilter::ACTIVE_TUPLE + 1);
 
+/**
+ * Collect the pairs of outer and inner columns that the predicate, taken
+ * as a conjunction, requires to be equal.
+ */
+static void collectEquiJoinColumns(const AbstractExpression* predicate,
+                                   std::vector<int>& outerColumns,
+                                   std::vector<int>& innerColumns) {
+    if (predicate == NULL) {
+        return;
+    }
+    if (predicate->getExpressionType() == EXPRESSION_TYPE_CONJUNCTION_AND) {
+        collectEquiJoinColumns(predicate->getLeft(), outerColumns, innerColumns);
+        collectEquiJoinColumns(predicate->getRight(), outerColumns, innerColumns);
+        return;
+    }
+    if (predicate->getExpressionType() != EXPRESSION_TYPE_COMPARE_EQUAL ||
+        predicate->getLeft()->getExpressionType() != EXPRESSION_TYPE_VALUE_TUPLE ||
+        predicate->getRight()->getExpressionType() != EXPRESSION_TYPE_VALUE_TUPLE) {
+        return;
+    }
+    const TupleValueExpression* left = static_cast<const TupleValueExpression*>(predicate->getLeft());
+    const TupleValueExpression* right = static_cast<const TupleValueExpression*>(predicate->getRight());
+    if (left->getTupleId() == right->getTupleId()) {
+        return;
+    }
+    if (left->getTupleId() != 0) {
+        std::swap(left, right);
+    }
+    outerColumns.push_back(left->getColumnId());
+    innerColumns.push_back(right->getColumnId());
+}
+
 bool NestLoopExecutor::p_init(AbstractPlanNode* abstractNode,
                                    TempTableLimits* limits)
 {
@@ -94,6 +129,32 @@ bool NestLoopExecutor::p_init(AbstractPlanNode* abstractNode,
     // NULL tuples for left and full joins
     p_init_null_tuples(node->getInputTable(), node->getInputTable(1));
 
+    //
+    // OPTIMIZATION: SEMI-JOIN FILTER
+    //
+    // An inner or left join outputs only the inner tuples that match some
+    // outer tuple. The outer table is complete by the time the inner scan
+    // runs, so have the scan drop the tuples whose equi-join key no outer
+    // tuple has before it does anything else with them.
+    //
+    if (m_joinType != JOIN_TYPE_FULL) {
+        std::vector<int> outerColumns;
+        std::vector<int> innerColumns;
+        collectEquiJoinColumns(node->getJoinPredicate(), outerColumns, innerColumns);
+        if (m_joinType == JOIN_TYPE_INNER) {
+            collectEquiJoinColumns(node->getWherePredicate(), outerColumns, innerColumns);
+        }
+        if ( ! outerColumns.empty()) {
+            AbstractExecutor* innerExecutor = node->getChildren()[1]->getExecutor();
+            if (SeqScanExecutor* seqScan = dynamic_cast<SeqScanExecutor*>(innerExecutor)) {
+                seqScan->setSemiJoinFilter(node->getChildren()[0], outerColumns, innerColumns);
+            }
+            else if (IndexScanExecutor* indexScan = dynamic_cast<IndexScanExecutor*>(innerExecutor)) {
+                indexScan->setSemiJoinFilter(node->getChildren()[0], outerColumns, innerColumns);
+            }
+        }
+    }
+
     return true;
 }
 
@@ -188,6 +249,9 @@ bool NestLoopExecutor::p_execute(const NValueArray &params) {
         // For outer joins if outer tuple fails pre-join predicate
         // (join expression based on the outer table only)
         // it can't match any of inner tuples
+        if (preJoinPredicate != NULL) {
+            ++m_profile.m_predicateEvaluations;
+        }
         if (preJoinPredicate == NULL || preJoinPredicate->eval(&outer_tuple, NULL).isTrue()) {
 
             // By default, the delete as we go flag is false.
@@ -196,6 +260,9 @@ bool NestLoopExecutor::p_execute(const NValueArray &params) {
                 pmp.countdownProgress();
                 // Apply join filter to produce matches for each outer that has them,
                 // then pad unmatched outers, then filter them all
+                if (joinPredicate != NULL) {
+                    ++m_profile.m_predicateEvaluations;
+                }
                 if (joinPredicate == NULL || joinPredicate->eval(&outer_tuple, &inner_tuple).isTrue()) {
                     outerMatch = true;
                     // The inner tuple passed the join predicate
@@ -253,6 +320,7 @@ bool NestLoopExecutor::p_execute(const NValueArray &params) {
     if (m_aggExec != NULL) {
         m_aggExec->p_execute_finish();
     }
+    m_profile.m_predicateEvaluations += postfilter.evaluationCount();
 
     cleanupInputTempTable(inner_table);
     cleanupInputTempTable(outer_table);
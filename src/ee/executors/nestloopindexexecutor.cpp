@@ -82,6 +82,47 @@ using namespace voltdb;
 const static int8_t UNMATCHED_TUPLE(TableTupleFilter::ACTIVE_TUPLE);
 const static int8_t MATCHED_TUPLE(TableTupleFilter::ACTIVE_TUPLE + 1);
 
+// How many outer tuples ahead of the current one to prefetch index probes for
+const static int PREFETCH_DISTANCE = 8;
+
+/**
+ * Can the probes of the index be prefetched? Only equality lookups on the
+ * whole key of an index that knows how to prefetch one are.
+ */
+static bool canPrefetchProbes(TableIndex* index, IndexLookupType lookupType, int numOfSearchKeys)
+{
+    return lookupType == INDEX_LOOKUP_TYPE_EQ &&
+        index->canPrefetchKeys() &&
+        numOfSearchKeys == index->getKeySchema()->columnCount();
+}
+
+/**
+ * Build the search key for an outer tuple that will be probed soon and
+ * have the index start loading the memory that probe will touch. Keys that
+ * the probe itself will not look up, because part of them is NULL or does
+ * not fit the index key, are skipped. So are any errors, which are left
+ * for the probe to raise, if it ever gets to that tuple.
+ */
+static void prefetchProbe(TableIndex* index,
+                          const std::vector<AbstractExpression*>& searchKeyExpressions,
+                          const TableTuple& keyTuple,
+                          const TableTuple& outerTuple)
+{
+    try {
+        for (size_t ctr = 0; ctr < searchKeyExpressions.size(); ctr++) {
+            NValue candidateValue = searchKeyExpressions[ctr]->eval(&outerTuple, NULL);
+            if (candidateValue.isNull()) {
+                return;
+            }
+            keyTuple.setNValue(ctr, candidateValue);
+        }
+    }
+    catch (const SQLException &e) {
+        return;
+    }
+    index->prefetchKey(&keyTuple);
+}
+
 bool NestLoopIndexExecutor::p_init(AbstractPlanNode* abstractNode,
                                    TempTableLimits* limits)
 {
@@ -147,6 +188,9 @@ bool NestLoopIndexExecutor::p_init(AbstractPlanNode* abstractNode,
     p_init_null_tuples(node->getInputTable(), m_indexNode->getTargetTable());
 
     m_indexValues.init(index->getKeySchema());
+    if (canPrefetchProbes(index, m_lookupType, num_of_searchkeys)) {
+        m_prefetchValues.init(index->getKeySchema());
+    }
     return true;
 }
 
@@ -279,12 +323,31 @@ bool NestLoopIndexExecutor::p_execute(const NValueArray &params)
         join_tuple = m_tmpOutputTable->tempTuple();
     }
 
+    // Each probe of the inner index is a walk through memory that is
+    // unlikely to be in cache. Where the index can prefetch, a second
+    // iterator runs a few outer tuples ahead and starts the memory loads
+    // for their probes, so that they overlap with the work on the current
+    // one. The outer tuples are still joined in their original order.
+    bool prefetching = canPrefetchProbes(index, m_lookupType, num_of_searchkeys);
+    TableIterator prefetch_iterator = outer_table->iterator();
+    TableTuple prefetch_tuple(outer_table->schema());
+    const TableTuple& prefetch_values = m_prefetchValues.tuple();
+    if (prefetching) {
+        for (int ii = 0; ii < PREFETCH_DISTANCE && prefetch_iterator.next(prefetch_tuple); ii++) {
+            prefetchProbe(index, m_indexNode->getSearchKeyExpressions(), prefetch_values, prefetch_tuple);
+        }
+    }
+
     VOLT_TRACE("<num_of_outer_cols>: %d\n", num_of_outer_cols);
     while (postfilter.isUnderLimit() && outer_iterator.next(outer_tuple)) {
         VOLT_TRACE("outer_tuple:%s",
                    outer_tuple.debug(outer_table->name()).c_str());
         pmp.countdownProgress();
 
+        if (prefetching && prefetch_iterator.next(prefetch_tuple)) {
+            prefetchProbe(index, m_indexNode->getSearchKeyExpressions(), prefetch_values, prefetch_tuple);
+        }
+
         // Set the join tuple columns that originate solely from the outer tuple.
         // Must be outside the inner loop in case of the empty inner table.
         join_tuple.setNValues(0, outer_tuple, 0, num_of_outer_cols);
@@ -422,6 +485,7 @@ bool NestLoopIndexExecutor::p_execute(const NValueArray &params)
                 //
                 // Essentially cut and pasted this if ladder from
                 // index scan executor
+                ++m_profile.m_indexProbes;
                 if (num_of_searchkeys > 0) {
                     if (localLookupType == INDEX_LOOKUP_TYPE_EQ) {
                         index->moveToKey(&index_values, indexCursor);
@@ -506,6 +570,9 @@ bool NestLoopIndexExecutor::p_execute(const NValueArray &params)
                     //
                     // Then apply our post-predicate to do further filtering
                     //
+                    if (post_expression != NULL) {
+                        ++m_profile.m_predicateEvaluations;
+                    }
                     if (post_expression == NULL ||
                         post_expression->eval(&outer_tuple, &inner_tuple).isTrue()) {
                         outerMatch = true;
@@ -588,6 +655,7 @@ bool NestLoopIndexExecutor::p_execute(const NValueArray &params)
     if (m_aggExec != NULL) {
         m_aggExec->p_execute_finish();
     }
+    m_profile.m_predicateEvaluations += postfilter.evaluationCount();
 
     VOLT_TRACE ("result table:\n %s", m_tmpOutputTable->debug().c_str());
     VOLT_TRACE("Finished NestLoopIndex");
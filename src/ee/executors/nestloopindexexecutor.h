@@ -91,6 +91,8 @@ protected:
     std::vector<AbstractExpression*> m_outputExpressions;
     SortDirectionType m_sortDirection;
     StandAloneTupleStorage m_indexValues;
+    // search key of an outer tuple further ahead, used to prefetch its probe
+    StandAloneTupleStorage m_prefetchValues;
 };
 
 }
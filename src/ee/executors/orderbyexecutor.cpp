@@ -48,6 +48,7 @@
 #include "common/common.h"
 #include "common/tabletuple.h"
 #include "common/FatalException.hpp"
+#include "common/Pool.hpp"
 #include "execution/ProgressMonitorProxy.h"
 #include "plannodes/orderbynode.h"
 #include "plannodes/limitnode.h"
@@ -62,6 +63,9 @@
 using namespace voltdb;
 using namespace std;
 
+// Copies of the pushed tuples that are kept are allocated in chunks of this size.
+static const uint64_t HEAP_POOL_CHUNK_SIZE = 64 * 1024;
+
 bool
 OrderByExecutor::p_init(AbstractPlanNode* abstract_node,
                         TempTableLimits* limits)
@@ -103,6 +107,105 @@ OrderByExecutor::p_init(AbstractPlanNode* abstract_node,
     return true;
 }
 
+TempTableTupleSink*
+OrderByExecutor::getPipelinedInputSink()
+{
+    // Without a limit there is nothing to gain over sorting the input table.
+    if (m_abstractNode->isInline() || limit_node == NULL) {
+        return NULL;
+    }
+    return this;
+}
+
+void
+OrderByExecutor::startPipelinedInput(const NValueArray &params)
+{
+    int limit = -1;
+    int offset = -1;
+    limit_node->getLimitAndOffsetByReference(params, limit, offset);
+    startHeap(limit, offset, true);
+}
+
+void
+OrderByExecutor::pushTuple(TableTuple &tuple)
+{
+    addToHeap(tuple);
+}
+
+void
+OrderByExecutor::startHeap(int limit, int offset, bool copyTuples)
+{
+    clearHeap();
+    if (m_comparer == NULL) {
+        OrderByPlanNode* node = static_cast<OrderByPlanNode*>(m_abstractNode);
+        m_comparer.reset(new AbstractExecutor::TupleComparer(node->getSortExpressions(),
+                                                             node->getSortDirections()));
+    }
+    m_heapCapacity = -1;
+    if (limit >= 0) {
+        m_heapCapacity = static_cast<int64_t>(limit) + std::max(offset, 0);
+    }
+    m_copyHeapTuples = copyTuples;
+}
+
+void
+OrderByExecutor::addToHeap(const TableTuple &tuple)
+{
+    assert(tuple.isActive());
+    if (m_heapCapacity == 0) {
+        return;
+    }
+    if (m_heapCapacity < 0 || static_cast<int64_t>(m_heap.size()) < m_heapCapacity) {
+        if ( ! m_copyHeapTuples) {
+            m_heap.push_back(tuple);
+        }
+        else {
+            if (m_heapPool == NULL) {
+                m_heapPool.reset(new Pool(HEAP_POOL_CHUNK_SIZE, 1));
+            }
+            TableTuple copy(tuple.getSchema());
+            if (m_limits != NULL) {
+                m_limits->increaseAllocated(copy.tupleLength());
+            }
+            m_heapMemory += copy.tupleLength();
+            copy.move(m_heapPool->allocate(copy.tupleLength()));
+            copy.copy(tuple);
+            m_heap.push_back(copy);
+        }
+        if (m_heapCapacity >= 0) {
+            push_heap(m_heap.begin(), m_heap.end(), *m_comparer);
+        }
+        return;
+    }
+
+    // The heap is full, so the tuple has to sort before the last one kept.
+    if ( ! (*m_comparer)(tuple, m_heap.front())) {
+        return;
+    }
+    pop_heap(m_heap.begin(), m_heap.end(), *m_comparer);
+    if (m_copyHeapTuples) {
+        // Reuse the storage of the tuple that was dropped.
+        m_heap.back().copy(tuple);
+    }
+    else {
+        m_heap.back() = tuple;
+    }
+    push_heap(m_heap.begin(), m_heap.end(), *m_comparer);
+}
+
+void
+OrderByExecutor::clearHeap()
+{
+    m_heap.clear();
+    if (m_heapPool != NULL) {
+        m_heapPool->purge();
+    }
+    if (m_limits != NULL && m_heapMemory > 0) {
+        m_limits->reduceAllocated(static_cast<int>(m_heapMemory));
+    }
+    m_heapMemory = 0;
+}
+
 bool
 OrderByExecutor::p_execute(const NValueArray &params)
 {
@@ -125,67 +228,57 @@ OrderByExecutor::p_execute(const NValueArray &params)
     }
 
     VOLT_TRACE("Running OrderBy '%s'", m_abstractNode->debug().c_str());
-    VOLT_TRACE("Input Table:\n '%s'", input_table->debug().c_str());
-    TableIterator iterator = input_table->iterator();
-    TableTuple tuple(input_table->schema());
-
-    // If limit == 0 we have no work here.  There's no need to sort anything,
-    // or to fetch the vector of tuples from the input.  If limit < 0 we
-    // need to do the loop below, though.  The only case where we can skip
-    // is if limit == 0.
-    if (limit != 0) {
-        vector<TableTuple> xs;
-        ProgressMonitorProxy pmp(m_engine, this);
-        while (iterator.next(tuple))
-        {
-            pmp.countdownProgress();
-            assert(tuple.isActive());
-            xs.push_back(tuple);
-        }
-        VOLT_TRACE("\n***** Input Table PreSort:\n '%s'",
-                   input_table->debug().c_str());
-
-
-        if (limit >= 0 && xs.begin() + limit + offset < xs.end()) {
-            // partial sort
-            partial_sort(xs.begin(), xs.begin() + limit + offset, xs.end(),
-                    AbstractExecutor::TupleComparer(node->getSortExpressions(), node->getSortDirections()));
-        } else {
-            // full sort
-            sort(xs.begin(), xs.end(),
-                    AbstractExecutor::TupleComparer(node->getSortExpressions(), node->getSortDirections()));
-        }
+    ProgressMonitorProxy pmp(m_engine, this);
 
-        int tuple_ctr = 0;
-        int tuple_skipped = 0;
-        // If (limit < 0), so we don't have a limit at all, then just compare
-        // the iterator with the end.  Otherwise check that the tuple_counter is
-        // not over the limit.
-        for (vector<TableTuple>::iterator it = xs.begin();
-             ((limit < 0) || (tuple_ctr < limit)) && it != xs.end();
-             it++)
-        {
-            //
-            // Check if has gone past the offset
-            //
-            if (tuple_skipped < offset) {
-                tuple_skipped++;
-                continue;
+    // With pipelined input, the children have already pushed their
+    // tuples into the heap. Otherwise the input table outlives the sort,
+    // so the heap can refer to its tuples instead of copying them.
+    if ( ! m_pipelinedInput) {
+        VOLT_TRACE("Input Table:\n '%s'", input_table->debug().c_str());
+        startHeap(limit, offset, false);
+        // If limit == 0 we have no work here.  There's no need to sort anything,
+        // or to fetch the tuples from the input.
+        if (limit != 0) {
+            TableIterator iterator = input_table->iterator();
+            TableTuple tuple(input_table->schema());
+            while (iterator.next(tuple))
+            {
+                pmp.countdownProgress();
+                addToHeap(tuple);
             }
+        }
+    }
 
-            VOLT_TRACE("\n***** Input Table PostSort:\n '%s'",
-                       input_table->debug().c_str());
-            output_table->insertTempTuple(*it);
-            pmp.countdownProgress();
-            tuple_ctr += 1;
+    if (m_heapCapacity >= 0) {
+        sort_heap(m_heap.begin(), m_heap.end(), *m_comparer);
+    }
+    else {
+        sort(m_heap.begin(), m_heap.end(), *m_comparer);
+    }
+
+    // The heap holds no more than LIMIT + OFFSET tuples, so past the
+    // OFFSET everything it holds is output.
+    int tuple_skipped = 0;
+    for (vector<TableTuple>::iterator it = m_heap.begin(); it != m_heap.end(); it++)
+    {
+        //
+        // Check if has gone past the offset
+        //
+        if (tuple_skipped < offset) {
+            tuple_skipped++;
+            continue;
         }
+        output_table->insertTempTuple(*it);
+        pmp.countdownProgress();
     }
     VOLT_TRACE("Result of OrderBy:\n '%s'", output_table->debug().c_str());
 
+    clearHeap();
     cleanupInputTempTable(input_table);
 
     return true;
 }
 
 OrderByExecutor::~OrderByExecutor() {
+    clearHeap();
 }
@@ -50,29 +50,60 @@
 #include "common/valuevector.h"
 #include "executors/abstractexecutor.h"
 
+#include "boost/scoped_ptr.hpp"
+
+#include <vector>
+
 namespace voltdb {
 
     class UndoLog;
     class ReadWriteSet;
     class LimitPlanNode;
+    class Pool;
 
     /**
-     *
+     * Sorts its input. With an inline LIMIT, only the best LIMIT + OFFSET
+     * tuples seen so far are kept, in a heap whose worst tuple is on top,
+     * and a tuple that does not beat that one is dropped as it arrives.
+     * Children that produce their output one tuple at a time push it
+     * straight into the heap, copying only the tuples that get in.
      */
-    class OrderByExecutor : public AbstractExecutor {
+    class OrderByExecutor : public AbstractExecutor, public TempTableTupleSink {
     public:
         OrderByExecutor(VoltDBEngine *engine, AbstractPlanNode* abstract_node)
             : AbstractExecutor(engine, abstract_node), limit_node(NULL)
+            , m_heapCapacity(-1), m_copyHeapTuples(false), m_heapMemory(0)
             { }
         ~OrderByExecutor();
 
+        TempTableTupleSink* getPipelinedInputSink();
+        void startPipelinedInput(const NValueArray &params);
+        void pushTuple(TableTuple &tuple);
+
+        void cleanupMemoryPool() { clearHeap(); }
+
     protected:
         bool p_init(AbstractPlanNode* abstract_node,
                     TempTableLimits* limits);
         bool p_execute(const NValueArray &params);
 
     private:
+        void startHeap(int limit, int offset, bool copyTuples);
+        void addToHeap(const TableTuple &tuple);
+        void clearHeap();
+
         LimitPlanNode *limit_node;
+
+        boost::scoped_ptr<AbstractExecutor::TupleComparer> m_comparer;
+        // the tuples kept so far, as a heap with the last one in sort order on top
+        std::vector<TableTuple> m_heap;
+        // LIMIT + OFFSET, or -1 to keep every tuple
+        int64_t m_heapCapacity;
+        // pushed tuples do not outlive the push, so they are copied into the pool
+        bool m_copyHeapTuples;
+        boost::scoped_ptr<Pool> m_heapPool;
+        // the pool memory charged to the temp table limits
+        int64_t m_heapMemory;
     };
 
 }
@@ -19,7 +19,16 @@
  */
 
 #include "executors/partitionbyexecutor.h"
+
+#include "common/SerializableEEException.h"
+#include "common/ValueFactory.hpp"
+#include "execution/ProgressMonitorProxy.h"
 #include "plannodes/partitionbynode.h"
+#include "storage/table.h"
+#include "storage/tableiterator.h"
+#include "storage/temptable.h"
+
+#include <deque>
 
 namespace voltdb {
 
@@ -35,7 +44,343 @@ bool PartitionByExecutor::p_init(AbstractPlanNode *node, TempTableLimits *limits
     if (!AggregateSerialExecutor::p_init(node, limits)) {
         return false;
     }
+    m_partitionByNode = dynamic_cast<PartitionByPlanNode*>(node);
+    assert(m_partitionByNode);
+
+    for (int ii = 0; ii < m_aggTypes.size(); ii++) {
+        switch (m_aggTypes[ii]) {
+        case EXPRESSION_TYPE_AGGREGATE_WINDOWED_RANK:
+        case EXPRESSION_TYPE_AGGREGATE_WINDOWED_DENSE_RANK:
+        case EXPRESSION_TYPE_AGGREGATE_COUNT_STAR:
+        case EXPRESSION_TYPE_AGGREGATE_COUNT:
+        case EXPRESSION_TYPE_AGGREGATE_SUM:
+        case EXPRESSION_TYPE_AGGREGATE_AVG:
+        case EXPRESSION_TYPE_AGGREGATE_MIN:
+        case EXPRESSION_TYPE_AGGREGATE_MAX:
+            break;
+        default:
+        {
+            char message[128];
+            snprintf(message, sizeof(message), "Unsupported windowed aggregate type %d", m_aggTypes[ii]);
+            throw SerializableEEException(VOLT_EE_EXCEPTION_TYPE_EEEXCEPTION, message);
+        }
+        }
+        if (m_distinctAggs[ii]) {
+            throw SerializableEEException(VOLT_EE_EXCEPTION_TYPE_EEEXCEPTION,
+                                          "DISTINCT is not supported for windowed aggregates");
+        }
+    }
+    return true;
+}
+
+bool PartitionByExecutor::p_execute(const NValueArray& params) {
+    Table* input_table = m_abstractNode->getInputTable();
+    assert(input_table);
+    VOLT_TRACE("input table\n%s", input_table->debug().c_str());
+    const TupleSchema* inputSchema = input_table->schema();
+    TableIterator it = input_table->iteratorDeletingAsWeGo();
+    TableTuple nextTuple(inputSchema);
+
+    ProgressMonitorProxy pmp(m_engine, this);
+    AggregateExecutorBase::p_execute_init(params, &pmp, inputSchema, NULL);
+
+    const size_t tupleLength = inputSchema->tupleLength() + TUPLE_HEADER_SIZE;
+    while (m_postfilter.isUnderLimit() && it.next(nextTuple)) {
+        m_pmp->countdownProgress();
+        if ( ! m_partitionRows.empty() && isNewPartition(nextTuple)) {
+            outputPartition();
+        }
+        // The input is deleted as we go, so keep a copy of the row.  Any
+        // out-of-line values belong to the input's sources and stay put.
+        char* storage = static_cast<char*>(m_partitionPool.allocate(tupleLength));
+        ::memcpy(storage, nextTuple.address(), tupleLength);
+        m_partitionRows.push_back(TableTuple(storage, inputSchema));
+    }
+    if (m_postfilter.isUnderLimit() && ! m_partitionRows.empty()) {
+        outputPartition();
+    }
+    m_partitionRows.clear();
+    m_partitionPool.purge();
+
+    AggregateExecutorBase::p_execute_finish();
+    cleanupInputTempTable(input_table);
     return true;
 }
 
+bool PartitionByExecutor::isNewPartition(const TableTuple& nextTuple) const {
+    const TableTuple& lastTuple = m_partitionRows.back();
+    for (int ii = 0; ii < m_groupByExpressions.size(); ii++) {
+        if (m_groupByExpressions[ii]->eval(&nextTuple).compare(m_groupByExpressions[ii]->eval(&lastTuple)) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void PartitionByExecutor::outputPartition() {
+    const size_t rowCount = m_partitionRows.size();
+    const std::vector<AbstractExpression*>& sortExpressions = m_partitionByNode->getSortExpressions();
+    const size_t sortCount = sortExpressions.size();
+
+    // Rows with the same order by values are peers.
+    m_orderByValues.resize(rowCount * sortCount);
+    for (size_t row = 0; row < rowCount; row++) {
+        for (size_t ii = 0; ii < sortCount; ii++) {
+            m_orderByValues[row * sortCount + ii] = sortExpressions[ii]->eval(&m_partitionRows[row]);
+        }
+    }
+    m_peerStart.resize(rowCount);
+    m_peerEnd.resize(rowCount);
+    size_t groupStart = 0;
+    for (size_t row = 1; row <= rowCount; row++) {
+        bool isPeer = (row < rowCount);
+        for (size_t ii = 0; isPeer && ii < sortCount; ii++) {
+            isPeer = (m_orderByValues[row * sortCount + ii].compare(m_orderByValues[groupStart * sortCount + ii]) == 0);
+        }
+        if ( ! isPeer) {
+            for (size_t peer = groupStart; peer < row; peer++) {
+                m_peerStart[peer] = groupStart;
+                m_peerEnd[peer] = row;
+            }
+            groupStart = row;
+        }
+    }
+    computeFrames();
+
+    std::vector<std::vector<NValue> > results(m_aggTypes.size());
+    for (int ii = 0; ii < m_aggTypes.size(); ii++) {
+        computeAggregate(ii, results[ii]);
+    }
+
+    TableTuple& tempTuple = m_tmpOutputTable->tempTuple();
+    const TupleSchema* outputSchema = tempTuple.getSchema();
+    for (size_t row = 0; row < rowCount && m_postfilter.isUnderLimit(); row++) {
+        for (int ii = 0; ii < m_aggregateOutputColumns.size(); ii++) {
+            const int columnIndex = m_aggregateOutputColumns[ii];
+            tempTuple.setNValue(columnIndex, results[ii][row].castAs(outputSchema->columnType(columnIndex)));
+        }
+        BOOST_FOREACH(int output_col_index, m_passThroughColumns) {
+            tempTuple.setNValue(output_col_index,
+                                m_outputColumnExpressions[output_col_index]->eval(&m_partitionRows[row]));
+        }
+        if (m_postfilter.eval(&tempTuple, NULL)) {
+            m_tmpOutputTable->insertTempTuple(tempTuple);
+            m_pmp->countdownProgress();
+        }
+    }
+
+    m_partitionRows.clear();
+    m_partitionPool.purge();
+}
+
+void PartitionByExecutor::computeFrames() {
+    const size_t rowCount = m_partitionRows.size();
+    const WindowFrameBound& start = m_partitionByNode->getFrameStart();
+    const WindowFrameBound& end = m_partitionByNode->getFrameEnd();
+    m_frameStart.resize(rowCount);
+    m_frameEnd.resize(rowCount);
+
+    if (m_partitionByNode->getFrameUnit() == WINDOW_FRAME_UNIT_RANGE) {
+        for (size_t row = 0; row < rowCount; row++) {
+            m_frameStart[row] = (start.m_type == WINDOW_FRAME_BOUND_UNBOUNDED_PRECEDING) ? 0 : m_peerStart[row];
+            m_frameEnd[row] = (end.m_type == WINDOW_FRAME_BOUND_UNBOUNDED_FOLLOWING) ? rowCount : m_peerEnd[row];
+        }
+        if (start.m_type == WINDOW_FRAME_BOUND_PRECEDING || start.m_type == WINDOW_FRAME_BOUND_FOLLOWING) {
+            computeRangeOffsetBound(start, true, m_frameStart);
+        }
+        if (end.m_type == WINDOW_FRAME_BOUND_PRECEDING || end.m_type == WINDOW_FRAME_BOUND_FOLLOWING) {
+            computeRangeOffsetBound(end, false, m_frameEnd);
+        }
+        return;
+    }
+
+    for (size_t row = 0; row < rowCount; row++) {
+        switch (start.m_type) {
+        case WINDOW_FRAME_BOUND_UNBOUNDED_PRECEDING:
+            m_frameStart[row] = 0;
+            break;
+        case WINDOW_FRAME_BOUND_PRECEDING:
+            m_frameStart[row] = (row > static_cast<size_t>(start.m_offset)) ? row - start.m_offset : 0;
+            break;
+        case WINDOW_FRAME_BOUND_FOLLOWING:
+            m_frameStart[row] = std::min(rowCount, static_cast<size_t>(row + start.m_offset));
+            break;
+        default:
+            m_frameStart[row] = row;
+            break;
+        }
+        switch (end.m_type) {
+        case WINDOW_FRAME_BOUND_UNBOUNDED_FOLLOWING:
+            m_frameEnd[row] = rowCount;
+            break;
+        case WINDOW_FRAME_BOUND_PRECEDING:
+            m_frameEnd[row] = (row + 1 > static_cast<size_t>(end.m_offset)) ? row + 1 - end.m_offset : 0;
+            break;
+        case WINDOW_FRAME_BOUND_FOLLOWING:
+            m_frameEnd[row] = std::min(rowCount, static_cast<size_t>(row + 1 + end.m_offset));
+            break;
+        default:
+            m_frameEnd[row] = row + 1;
+            break;
+        }
+    }
+}
+
+/*
+ * A RANGE bound with an offset is the first row (for the start) or one
+ * past the last row (for the end) whose order by value is within the
+ * offset of the current row's.  Since the values are sorted, the bound
+ * only moves forwards from one row to the next.  NULLs sort lowest and
+ * are never within an offset of a non-NULL value, so a row with a NULL
+ * value keeps its peers as its bound.
+ */
+void PartitionByExecutor::computeRangeOffsetBound(const WindowFrameBound& bound, bool isStart,
+                                                  std::vector<size_t>& bounds) const {
+    const size_t rowCount = m_partitionRows.size();
+    const bool ascending = (m_partitionByNode->getSortDirections()[0] != SORT_DIRECTION_TYPE_DESC);
+    // Going forwards in the sort order means adding the offset to ascending values.
+    const bool addOffset = ascending == (bound.m_type == WINDOW_FRAME_BOUND_FOLLOWING);
+    const NValue offset = ValueFactory::getBigIntValue(bound.m_offset);
+
+    size_t candidate = 0;
+    for (size_t row = 0; row < rowCount; row++) {
+        const NValue& current = m_orderByValues[row];
+        if (current.isNull()) {
+            continue;
+        }
+        const NValue limit = addOffset ? current.op_add(offset) : current.op_subtract(offset);
+        // Skip the rows before the start, or the rows up to the end.
+        while (candidate < rowCount) {
+            int cmp = m_orderByValues[candidate].compare(limit);
+            if ( ! ascending) {
+                cmp = -cmp;
+            }
+            if (isStart ? cmp >= 0 : cmp > 0) {
+                break;
+            }
+            ++candidate;
+        }
+        bounds[row] = candidate;
+    }
+}
+
+void PartitionByExecutor::computeAggregate(int aggIndex, std::vector<NValue>& results) {
+    const size_t rowCount = m_partitionRows.size();
+    const ExpressionType aggType = m_aggTypes[aggIndex];
+    results.resize(rowCount);
+
+    if (aggType == EXPRESSION_TYPE_AGGREGATE_WINDOWED_RANK ||
+        aggType == EXPRESSION_TYPE_AGGREGATE_WINDOWED_DENSE_RANK) {
+        int64_t denseRank = 0;
+        for (size_t row = 0; row < rowCount; row++) {
+            if (m_peerStart[row] == row) {
+                ++denseRank;
+            }
+            int64_t rank = (aggType == EXPRESSION_TYPE_AGGREGATE_WINDOWED_RANK) ?
+                    static_cast<int64_t>(m_peerStart[row] + 1) : denseRank;
+            results[row] = ValueFactory::getBigIntValue(rank);
+        }
+        return;
+    }
+
+    if (aggType == EXPRESSION_TYPE_AGGREGATE_COUNT_STAR) {
+        for (size_t row = 0; row < rowCount; row++) {
+            int64_t count = (m_frameEnd[row] > m_frameStart[row]) ? m_frameEnd[row] - m_frameStart[row] : 0;
+            results[row] = ValueFactory::getBigIntValue(count);
+        }
+        return;
+    }
+
+    AbstractExpression* inputExpr = m_inputExpressions[aggIndex];
+    assert(inputExpr);
+    std::vector<NValue> values(rowCount);
+    for (size_t row = 0; row < rowCount; row++) {
+        values[row] = inputExpr->eval(&m_partitionRows[row]);
+    }
+
+    if (aggType == EXPRESSION_TYPE_AGGREGATE_MIN || aggType == EXPRESSION_TYPE_AGGREGATE_MAX) {
+        computeExtremes(values, aggType == EXPRESSION_TYPE_AGGREGATE_MIN, results);
+        return;
+    }
+
+    // COUNT, SUM and AVG keep a running sum and count of the non-NULL
+    // values between windowStart and windowEnd.  The sum is started over
+    // whenever the frame holds no values, so that rounding of
+    // floating point values does not pile up over a whole partition.
+    size_t windowStart = 0;
+    size_t windowEnd = 0;
+    int64_t count = 0;
+    NValue sum;
+    for (size_t row = 0; row < rowCount; row++) {
+        const size_t frameStart = m_frameStart[row];
+        const size_t frameEnd = std::max(m_frameEnd[row], frameStart);
+        if (frameStart >= windowEnd) {
+            // The frame has moved past everything being summed.
+            windowStart = windowEnd = frameStart;
+            count = 0;
+        }
+        for (; windowStart < frameStart; windowStart++) {
+            if ( ! values[windowStart].isNull()) {
+                if (--count > 0) {
+                    sum = sum.op_subtract(values[windowStart]);
+                }
+            }
+        }
+        for (; windowEnd < frameEnd; windowEnd++) {
+            if ( ! values[windowEnd].isNull()) {
+                sum = (count++ == 0) ? values[windowEnd] : sum.op_add(values[windowEnd]);
+            }
+        }
+
+        if (aggType == EXPRESSION_TYPE_AGGREGATE_COUNT) {
+            results[row] = ValueFactory::getBigIntValue(count);
+        } else if (count == 0) {
+            results[row] = NValue::getNullValue(VALUE_TYPE_BIGINT);
+        } else if (aggType == EXPRESSION_TYPE_AGGREGATE_AVG) {
+            results[row] = sum.op_divide(ValueFactory::getBigIntValue(count));
+        } else {
+            results[row] = sum;
+        }
+    }
+}
+
+/*
+ * The queue holds, in frame order, the rows of the frame that could still
+ * become its MIN (or MAX): each one has a smaller (larger) value than all
+ * the rows queued before it.  The front of the queue is the answer.
+ */
+void PartitionByExecutor::computeExtremes(const std::vector<NValue>& values, bool isMin,
+                                          std::vector<NValue>& results) const {
+    const size_t rowCount = values.size();
+    std::deque<size_t> candidates;
+    size_t windowEnd = 0;
+    for (size_t row = 0; row < rowCount; row++) {
+        const size_t frameStart = m_frameStart[row];
+        const size_t frameEnd = std::max(m_frameEnd[row], frameStart);
+        windowEnd = std::max(windowEnd, frameStart);
+        for (; windowEnd < frameEnd; windowEnd++) {
+            const NValue& value = values[windowEnd];
+            if (value.isNull()) {
+                continue;
+            }
+            while ( ! candidates.empty()) {
+                int cmp = values[candidates.back()].compare(value);
+                if (isMin ? cmp < 0 : cmp > 0) {
+                    break;
+                }
+                candidates.pop_back();
+            }
+            candidates.push_back(windowEnd);
+        }
+        while ( ! candidates.empty() && candidates.front() < frameStart) {
+            candidates.pop_front();
+        }
+        if (candidates.empty()) {
+            results[row] = NValue::getNullValue(VALUE_TYPE_BIGINT);
+        } else {
+            results[row] = values[candidates.front()];
+        }
+    }
+}
+
 } /* namespace voltdb */
@@ -19,22 +19,63 @@
 
 #include "aggregateexecutor.h"
 
+#include "common/Pool.hpp"
+#include "plannodes/partitionbynode.h"
+
+#include <vector>
+
 namespace voltdb {
 
 /**
- * This is the executor for a PartitionByPlanNode.  This is almost exactly like
- * an AggregateSerialExecutor, but the initialization is slightly different, and
- * we specify that we output one row for each input row.
+ * This is the executor for a PartitionByPlanNode.  Its input is sorted
+ * on the partition by and order by expressions, and it outputs one row
+ * for each input row.
+ *
+ * The rows of each partition are collected and then the windowed
+ * aggregates are computed for all of them in a single pass, in which the
+ * window frame only moves forwards.  COUNT, SUM and AVG add the values
+ * entering the frame and take away the values leaving it, and MIN and MAX
+ * keep a queue of the frame's candidate extremes in frame order, so every
+ * aggregate costs O(1) amortized per row whatever the size of the frame.
  */
 class PartitionByExecutor: public AggregateSerialExecutor {
 public:
     PartitionByExecutor(VoltDBEngine* engine, AbstractPlanNode* abstract_node)
-      : AggregateSerialExecutor(engine, abstract_node) {
+      : AggregateSerialExecutor(engine, abstract_node)
+      , m_partitionByNode(NULL)
+      , m_partitionPool(TEMP_POOL_CHUNK_SIZE, 1) {
     }
     virtual ~PartitionByExecutor();
     bool outputForEachInputRow() const;
 protected:
     virtual bool p_init(AbstractPlanNode*, TempTableLimits*);
+private:
+    virtual bool p_execute(const NValueArray& params);
+
+    bool isNewPartition(const TableTuple& nextTuple) const;
+    void outputPartition();
+
+    /// Find the first and one past the last row of each row's frame.
+    void computeFrames();
+    void computeRangeOffsetBound(const WindowFrameBound& bound, bool isStart,
+                                 std::vector<size_t>& bounds) const;
+
+    /// Compute the windowed aggregate aggIndex for each row of the partition.
+    void computeAggregate(int aggIndex, std::vector<NValue>& results);
+    void computeExtremes(const std::vector<NValue>& values, bool isMin, std::vector<NValue>& results) const;
+
+    PartitionByPlanNode* m_partitionByNode;
+
+    // Copies of the rows of the partition in progress
+    Pool m_partitionPool;
+    std::vector<TableTuple> m_partitionRows;
+
+    // Per-row state for the partition being output
+    std::vector<NValue> m_orderByValues;
+    std::vector<size_t> m_peerStart;
+    std::vector<size_t> m_peerEnd;
+    std::vector<size_t> m_frameStart;
+    std::vector<size_t> m_frameEnd;
 };
 
 } /* namespace voltdb */
@@ -102,6 +102,45 @@ bool ProjectionExecutor::p_init(AbstractPlanNode *abstractNode,
     return true;
 }
 
+inline void ProjectionExecutor::projectTuple(const TableTuple &tuple, const NValueArray &params) {
+    //
+    // Project (or replace) values from input tuple
+    //
+    TableTuple &temp_tuple = output_table->tempTuple();
+    if (all_tuple_array != NULL) {
+        VOLT_TRACE("sweet, all tuples");
+        for (int ctr = m_columnCount - 1; ctr >= 0; --ctr) {
+            temp_tuple.setNValue(ctr, tuple.getNValue(all_tuple_array[ctr]));
+        }
+    } else if (all_param_array != NULL) {
+        VOLT_TRACE("sweet, all params");
+        for (int ctr = m_columnCount - 1; ctr >= 0; --ctr) {
+            temp_tuple.setNValue(ctr, params[all_param_array[ctr]]);
+        }
+    } else {
+        for (int ctr = m_columnCount - 1; ctr >= 0; --ctr) {
+            temp_tuple.setNValue(ctr, expression_array[ctr]->eval(&tuple, NULL));
+        }
+    }
+    output_table->insertTempTuple(temp_tuple);
+}
+
+TempTableTupleSink* ProjectionExecutor::getPipelinedInputSink() {
+    if (m_abstractNode->isInline()) {
+        return NULL;
+    }
+    return this;
+}
+
+void ProjectionExecutor::startPipelinedInput(const NValueArray &params) {
+    m_params = &params;
+}
+
+void ProjectionExecutor::pushTuple(TableTuple &tuple) {
+    assert (m_params);
+    projectTuple(tuple, *m_params);
+}
+
 bool ProjectionExecutor::p_execute(const NValueArray &params) {
 #ifndef NDEBUG
     ProjectionPlanNode* node = dynamic_cast<ProjectionPlanNode*>(m_abstractNode);
@@ -111,6 +150,10 @@ bool ProjectionExecutor::p_execute(const NValueArray &params) {
                                 // called
     assert (output_table == dynamic_cast<TempTable*>(node->getOutputTable()));
     assert (output_table);
+    if (m_pipelinedInput) {
+        // The child has already pushed every tuple through projectTuple.
+        return true;
+    }
     Table* input_table = m_abstractNode->getInputTable();
     assert (input_table);
 
@@ -133,26 +176,7 @@ bool ProjectionExecutor::p_execute(const NValueArray &params) {
     TableIterator iterator = input_table->iteratorDeletingAsWeGo();
     assert (tuple.sizeInValues() == input_table->columnCount());
     while (iterator.next(tuple)) {
-        //
-        // Project (or replace) values from input tuple
-        //
-        TableTuple &temp_tuple = output_table->tempTuple();
-        if (all_tuple_array != NULL) {
-            VOLT_TRACE("sweet, all tuples");
-            for (int ctr = m_columnCount - 1; ctr >= 0; --ctr) {
-                temp_tuple.setNValue(ctr, tuple.getNValue(all_tuple_array[ctr]));
-            }
-        } else if (all_param_array != NULL) {
-            VOLT_TRACE("sweet, all params");
-            for (int ctr = m_columnCount - 1; ctr >= 0; --ctr) {
-                temp_tuple.setNValue(ctr, params[all_param_array[ctr]]);
-            }
-        } else {
-            for (int ctr = m_columnCount - 1; ctr >= 0; --ctr) {
-                temp_tuple.setNValue(ctr, expression_array[ctr]->eval(&tuple, NULL));
-            }
-        }
-        output_table->insertTempTuple(temp_tuple);
+        projectTuple(tuple, params);
 
         VOLT_TRACE("OUTPUT TABLE: %s\n", output_table->debug().c_str());
     }
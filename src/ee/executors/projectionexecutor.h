@@ -62,18 +62,25 @@ class Table;
 /**
  *
  */
-class ProjectionExecutor : public AbstractExecutor {
+class ProjectionExecutor : public AbstractExecutor, public TempTableTupleSink {
     public:
         ProjectionExecutor(VoltDBEngine *engine, AbstractPlanNode* abstract_node) : AbstractExecutor(engine, abstract_node) {
             output_table = NULL;
+            m_params = NULL;
         }
         ~ProjectionExecutor();
+
+        TempTableTupleSink* getPipelinedInputSink();
+        void startPipelinedInput(const NValueArray &params);
+        void pushTuple(TableTuple &tuple);
     protected:
         bool p_init(AbstractPlanNode*,
                     TempTableLimits* limits);
         bool p_execute(const NValueArray &params);
 
     private:
+        inline void projectTuple(const TableTuple &tuple, const NValueArray &params);
+
         TempTable* output_table;
         int m_columnCount;
         boost::shared_array<int> all_tuple_array_ptr;
@@ -86,6 +93,9 @@ class ProjectionExecutor : public AbstractExecutor {
 
         boost::shared_array<AbstractExpression*> expression_array_ptr;
         AbstractExpression** expression_array;
+
+        // params of the current execution, when the input is pipelined
+        const NValueArray* m_params;
 };
 
 }
@@ -48,19 +48,27 @@
 #include "common/common.h"
 #include "common/tabletuple.h"
 #include "common/FatalException.hpp"
+#include "common/ValuePeeker.hpp"
 #include "executors/aggregateexecutor.h"
 #include "executors/executorutil.h"
 #include "execution/ProgressMonitorProxy.h"
 #include "expressions/abstractexpression.h"
+#include "expressions/tuplevalueexpression.h"
 #include "plannodes/aggregatenode.h"
 #include "plannodes/seqscannode.h"
 #include "plannodes/projectionnode.h"
 #include "plannodes/limitnode.h"
+#include "storage/persistenttable.h"
 #include "storage/table.h"
 #include "storage/temptable.h"
 #include "storage/tablefactory.h"
 #include "storage/tableiterator.h"
 
+#include <boost/foreach.hpp>
+
+#include <algorithm>
+#include <limits>
+
 using namespace voltdb;
 
 bool SeqScanExecutor::p_init(AbstractPlanNode* abstract_node,
@@ -103,9 +111,143 @@ bool SeqScanExecutor::p_init(AbstractPlanNode* abstract_node,
     // Inline aggregation can be serial, partial or hash
     m_aggExec = voltdb::getInlineAggregateExecutor(node);
 
+    m_zoneMapBounds.clear();
+    if ( ! isSubquery && node->getPredicate() != NULL) {
+        collectZoneMapBounds(node->getPredicate());
+    }
+
     return true;
 }
 
+void SeqScanExecutor::collectZoneMapBounds(const AbstractExpression* expression) {
+    ExpressionType comparison = expression->getExpressionType();
+    if (comparison == EXPRESSION_TYPE_CONJUNCTION_AND) {
+        collectZoneMapBounds(expression->getLeft());
+        collectZoneMapBounds(expression->getRight());
+        return;
+    }
+
+    const AbstractExpression* column = expression->getLeft();
+    const AbstractExpression* value = expression->getRight();
+    switch (comparison) {
+    case EXPRESSION_TYPE_COMPARE_EQUAL:
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+    case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+        break;
+    default:
+        return;
+    }
+    if (column->getExpressionType() != EXPRESSION_TYPE_VALUE_TUPLE) {
+        std::swap(column, value);
+        switch (comparison) {
+        case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+            comparison = EXPRESSION_TYPE_COMPARE_GREATERTHAN;
+            break;
+        case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+            comparison = EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO;
+            break;
+        case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+            comparison = EXPRESSION_TYPE_COMPARE_LESSTHAN;
+            break;
+        case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+            comparison = EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO;
+            break;
+        default:
+            break;
+        }
+    }
+    if (column->getExpressionType() != EXPRESSION_TYPE_VALUE_TUPLE ||
+        (value->getExpressionType() != EXPRESSION_TYPE_VALUE_CONSTANT &&
+         value->getExpressionType() != EXPRESSION_TYPE_VALUE_PARAMETER)) {
+        return;
+    }
+    ZoneMapBound bound;
+    bound.m_column = static_cast<const TupleValueExpression*>(column)->getColumnId();
+    bound.m_comparison = comparison;
+    bound.m_value = value;
+    m_zoneMapBounds.push_back(bound);
+}
+
+/*
+ * Turn the bounds into ranges of zone mapped columns for this execution.
+ * Bounds with a null or non-integer value are left out, which only makes
+ * the filter let more blocks through.
+ */
+void SeqScanExecutor::buildZoneMapFilter(PersistentTable* table, ZoneMapFilter& filter) {
+    BOOST_FOREACH(const ZoneMapBound& bound, m_zoneMapBounds) {
+        const NValue value = bound.m_value->eval(NULL, NULL);
+        if (value.isNull()) {
+            continue;
+        }
+        switch (ValuePeeker::peekValueType(value)) {
+        case VALUE_TYPE_TINYINT:
+        case VALUE_TYPE_SMALLINT:
+        case VALUE_TYPE_INTEGER:
+        case VALUE_TYPE_BIGINT:
+        case VALUE_TYPE_TIMESTAMP:
+            break;
+        default:
+            continue;
+        }
+        const int slot = table->zoneMapSlot(bound.m_column);
+        if (slot < 0) {
+            continue;
+        }
+        const int64_t operand = ValuePeeker::peekAsBigInt(value);
+        int64_t low = std::numeric_limits<int64_t>::min();
+        int64_t high = std::numeric_limits<int64_t>::max();
+        switch (bound.m_comparison) {
+        case EXPRESSION_TYPE_COMPARE_EQUAL:
+            low = operand;
+            high = operand;
+            break;
+        case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+            if (operand == low) {
+                continue;
+            }
+            high = operand - 1;
+            break;
+        case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+            high = operand;
+            break;
+        case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+            if (operand == high) {
+                continue;
+            }
+            low = operand + 1;
+            break;
+        case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+            low = operand;
+            break;
+        default:
+            continue;
+        }
+        filter.restrict(slot, low, high);
+    }
+}
+
+void SeqScanExecutor::setSemiJoinFilter(const AbstractPlanNode* source,
+                                        const std::vector<int>& sourceColumns,
+                                        const std::vector<int>& outputColumns) {
+    SeqScanPlanNode* node = dynamic_cast<SeqScanPlanNode*>(m_abstractNode);
+    assert(node);
+    ProjectionPlanNode* projection_node =
+        dynamic_cast<ProjectionPlanNode*>(node->getInlinePlanNode(PLAN_NODE_TYPE_PROJECTION));
+    // A scan with neither outputs its input table as is.
+    if (node->getPredicate() == NULL && projection_node == NULL) {
+        return;
+    }
+    if (m_aggExec != NULL || node->getInlinePlanNode(PLAN_NODE_TYPE_LIMIT) != NULL) {
+        return;
+    }
+    Table* input_table = (node->isSubQuery()) ?
+            node->getChildren()[0]->getOutputTable():
+            node->getTargetTable();
+    m_semiJoinFilter.init(source, sourceColumns, outputColumns, input_table->schema(), projection_node);
+}
+
 bool SeqScanExecutor::p_execute(const NValueArray &params) {
     SeqScanPlanNode* node = dynamic_cast<SeqScanPlanNode*>(m_abstractNode);
     assert(node);
@@ -171,6 +313,35 @@ bool SeqScanExecutor::p_execute(const NValueArray &params) {
         TableIterator iterator = input_table->iteratorDeletingAsWeGo();
         AbstractExpression *predicate = node->getPredicate();
 
+        //
+        // OPTIMIZATION: ZONE MAPS
+        //
+        // Pass over the blocks of a persistent table that hold no value
+        // in the range the predicate asks for of some column. Zone maps
+        // are started for such columns once the table spans more than
+        // one block.
+        //
+        ZoneMapFilter zoneMapFilter;
+        PersistentTable* persistentTable = (node->isSubQuery() || m_zoneMapBounds.empty()) ?
+                NULL : dynamic_cast<PersistentTable*>(input_table);
+        if (persistentTable != NULL && persistentTable->allocatedBlockCount() > 1) {
+            buildZoneMapFilter(persistentTable, zoneMapFilter);
+            if ( ! zoneMapFilter.isEmpty()) {
+                iterator.setZoneMapFilter(&zoneMapFilter);
+            }
+        }
+
+        //
+        // OPTIMIZATION: SEMI-JOIN FILTER
+        //
+        // Drop up front the tuples that the join this scan feeds would
+        // find no partner for.
+        //
+        const bool semiJoinFiltered = m_semiJoinFilter.isActive();
+        if (semiJoinFiltered) {
+            m_semiJoinFilter.load();
+        }
+
         if (predicate)
         {
             VOLT_TRACE("SCAN PREDICATE :\n%s\n", predicate->debug(true).c_str());
@@ -205,6 +376,10 @@ bool SeqScanExecutor::p_execute(const NValueArray &params) {
                        (int)input_table->activeTupleCount());
             pmp.countdownProgress();
 
+            if (semiJoinFiltered && ! m_semiJoinFilter.mayMatch(tuple)) {
+                continue;
+            }
+
             //
             // For each tuple we need to evaluate it against our predicate and limit/offset
             //
@@ -234,6 +409,7 @@ bool SeqScanExecutor::p_execute(const NValueArray &params) {
         if (m_aggExec != NULL) {
             m_aggExec->p_execute_finish();
         }
+        m_profile.m_predicateEvaluations += postfilter.evaluationCount();
     }
     //* for debug */std::cout << "SeqScanExecutor: node id " << node->getPlanNodeId() <<
     //* for debug */    " output table " << (void*)output_table <<
@@ -49,12 +49,17 @@
 #include "common/common.h"
 #include "common/valuevector.h"
 #include "executors/abstractexecutor.h"
+#include "executors/executorutil.h"
 #include "execution/VoltDBEngine.h"
 
+#include <vector>
+
 namespace voltdb
 {
+    class AbstractExpression;
     class AggregateExecutorBase;
-    struct CountingPostfilter;
+    class PersistentTable;
+    class ZoneMapFilter;
 
     class SeqScanExecutor : public AbstractExecutor {
     public:
@@ -62,6 +67,18 @@ namespace voltdb
             : AbstractExecutor(engine, abstract_node)
             , m_aggExec(NULL)
         {}
+
+        /**
+         * Drop the tuples whose values in the given output columns no
+         * output tuple of the source node has in the paired columns, as
+         * the inner side of an equi-join with it. The scan ignores this
+         * unless it copies its input into an output table of its own,
+         * with no inline LIMIT or aggregate.
+         */
+        void setSemiJoinFilter(const AbstractPlanNode* source,
+                               const std::vector<int>& sourceColumns,
+                               const std::vector<int>& outputColumns);
+
     protected:
         bool p_init(AbstractPlanNode* abstract_node,
                     TempTableLimits* limits);
@@ -71,7 +88,22 @@ namespace voltdb
 
         void outputTuple(CountingPostfilter& postfilter, TableTuple& tuple);
 
+        void collectZoneMapBounds(const AbstractExpression* expression);
+        void buildZoneMapFilter(PersistentTable* table, ZoneMapFilter& filter);
+
         AggregateExecutorBase* m_aggExec;
+
+        // A comparison of a column with a constant or a parameter that
+        // every tuple the predicate accepts must pass, with the column on
+        // the left. These let the scan pass over blocks by their zone maps.
+        struct ZoneMapBound {
+            int m_column;
+            ExpressionType m_comparison;
+            const AbstractExpression* m_value;
+        };
+        std::vector<ZoneMapBound> m_zoneMapBounds;
+
+        SemiJoinFilter m_semiJoinFilter;
     };
 }
 
@@ -372,7 +372,25 @@ bool UnionExecutor::p_init(AbstractPlanNode* abstract_node,
     return true;
 }
 
+TempTableTupleSink* UnionExecutor::getPipelinedInputSink() {
+    // Only UNION ALL can pass its input tuples on without looking at the
+    // others; the other set operations need all of their input at hand.
+    UnionPlanNode* node = static_cast<UnionPlanNode*>(m_abstractNode);
+    if (node->getUnionType() != UNION_TYPE_UNION_ALL) {
+        return NULL;
+    }
+    return this;
+}
+
+void UnionExecutor::pushTuple(TableTuple &tuple) {
+    static_cast<TempTable*>(m_abstractNode->getOutputTable())->insertTempTuple(tuple);
+}
+
 bool UnionExecutor::p_execute(const NValueArray &params) {
+    if (m_pipelinedInput) {
+        // The children have already pushed every tuple through pushTuple.
+        return true;
+    }
     return m_setOperator->processTuples();
 }
 
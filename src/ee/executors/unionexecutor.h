@@ -64,10 +64,13 @@ namespace detail {
 /**
  *
  */
-class UnionExecutor : public AbstractExecutor {
+class UnionExecutor : public AbstractExecutor, public TempTableTupleSink {
     public:
         UnionExecutor(VoltDBEngine *engine, AbstractPlanNode* abstract_node);
 
+        TempTableTupleSink* getPipelinedInputSink();
+        void pushTuple(TableTuple &tuple);
+
     protected:
         bool p_init(AbstractPlanNode*,
                     TempTableLimits* limits);
@@ -121,6 +121,12 @@ bool UpdateExecutor::p_init(AbstractPlanNode* abstract_node,
 
     assert(m_inputTargetMap.size() == (output_column_names.size() - 1));
     m_inputTargetMapSize = (int)m_inputTargetMap.size();
+
+    m_updatedColumns.assign(targettable_column_names.size(), false);
+    for (int ii = 0; ii < m_inputTargetMapSize; ++ii) {
+        m_updatedColumns[m_inputTargetMap[ii].second] = true;
+    }
+
     m_inputTuple = TableTuple(m_inputTable->schema());
 
     // for target table related info.
@@ -141,33 +147,25 @@ bool UpdateExecutor::p_execute(const NValueArray &params) {
     VOLT_TRACE("TARGET TABLE - BEFORE: %s\n", targetTable->debug().c_str());
 
     // determine which indices are updated by this executor
-    // iterate through all target table indices and see if they contain
-    // columns mutated by this executor
+    // from the target table columns it writes
     //
     // Shouldn't this be done in p_init?  See ticket ENG-8668.
     std::vector<TableIndex*> indexesToUpdate;
     const std::vector<TableIndex*>& allIndexes = targetTable->allIndexes();
     BOOST_FOREACH(TableIndex *index, allIndexes) {
-        bool indexKeyUpdated = false;
         BOOST_FOREACH(int colIndex, index->getAllColumnIndices()) {
-            std::pair<int, int> updateColInfo; // needs to be here because of macro failure
-            BOOST_FOREACH(updateColInfo, m_inputTargetMap) {
-                if (updateColInfo.second == colIndex) {
-                    indexKeyUpdated = true;
-                    break;
-                }
-            }
-            if (indexKeyUpdated) {
+            if (m_updatedColumns[colIndex]) {
+                indexesToUpdate.push_back(index);
                 break;
             }
         }
-        if (indexKeyUpdated) {
-            indexesToUpdate.push_back(index);
-        }
     }
+    // An update of columns no view reads, such as a counter, needs no view maintenance.
+    bool updateViews = targetTable->viewsDependOnColumns(m_updatedColumns);
 
     assert(m_inputTuple.sizeInValues() == m_inputTable->columnCount());
     assert(targetTuple.sizeInValues() == targetTable->columnCount());
+    ScopedDeferredViewUpdates deferredViewUpdates(targetTable);
     TableIterator input_iterator = m_inputTable->iterator();
     while (input_iterator.next(m_inputTuple)) {
         // The first column in the input table will be the address of a
@@ -203,8 +201,9 @@ bool UpdateExecutor::p_execute(const NValueArray &params) {
         }
 
         targetTable->updateTupleWithSpecificIndexes(targetTuple, tempTuple,
-                                                    indexesToUpdate);
+                                                    indexesToUpdate, true, true, updateViews);
     }
+    deferredViewUpdates.apply();
 
     TableTuple& count_tuple = m_node->getOutputTable()->tempTuple();
     count_tuple.setNValue(0, ValueFactory::getBigIntValue(m_inputTable->tempTableTupleCount()));
@@ -84,6 +84,9 @@ protected:
     std::vector<std::pair<int, int> > m_inputTargetMap;
     int m_inputTargetMapSize;
 
+    // Which target table columns the update writes, by column index.
+    std::vector<bool> m_updatedColumns;
+
     TempTable* m_inputTable;
 
     TableTuple m_inputTuple;
@@ -26,6 +26,7 @@
 #include "common/tabletuple.h"
 #include "storage/table.h"
 #include "storage/tableiterator.h"
+#include "storage/temptable.h"
 
 
 namespace voltdb {
@@ -121,7 +122,30 @@ NValue SubqueryExpression::eval(const TableTuple *tuple1, const TableTuple *tupl
 
     // Out of luck. Need to run the executors. Clean up the output tables with cached results
     exeContext->cleanupExecutorsForSubquery(m_subqueryId);
-    exeContext->executeExecutors(m_subqueryId);
+
+    // Unless the subquery has been run with these parameters before and its result is cached.
+    // The result is keyed by all the parameters, in the order of m_paramIdxs and then m_otherParamIdxs.
+    TempTable* outputTable = NULL;
+    std::vector<NValue> cacheKey;
+    if ( ! (m_paramIdxs.empty() && m_otherParamIdxs.empty())) {
+        outputTable = dynamic_cast<TempTable*>(exeContext->getSubqueryOutputTable(m_subqueryId));
+    }
+    bool cachedResult = false;
+    if (outputTable != NULL) {
+        cacheKey.reserve(m_paramIdxs.size() + m_otherParamIdxs.size());
+        for (size_t i = 0; i < m_paramIdxs.size(); ++i) {
+            cacheKey.push_back(parameterContainer[m_paramIdxs[i]].copyNValue());
+        }
+        for (size_t i = 0; i < m_otherParamIdxs.size(); ++i) {
+            cacheKey.push_back(parameterContainer[m_otherParamIdxs[i]].copyNValue());
+        }
+        SubqueryResultCache* cache = (context == NULL) ? NULL : context->getResultCache();
+        cachedResult = (cache != NULL) && cache->loadResult(cacheKey, outputTable);
+    }
+
+    if ( ! cachedResult) {
+        exeContext->executeExecutors(m_subqueryId);
+    }
 
     if (context == NULL) {
         // Preserve the value for the next run. Only 'other' parameters need to be copied
@@ -134,6 +158,10 @@ NValue SubqueryExpression::eval(const TableTuple *tuple1, const TableTuple *tupl
         context = exeContext->setSubqueryContext(m_subqueryId, lastParams);
     }
 
+    if (outputTable != NULL && ! cachedResult) {
+        context->getResultCache(outputTable->m_limits)->storeResult(cacheKey, outputTable);
+    }
+
     // Update the cached result for the current params. All params are already updated
     NValue retval = ValueFactory::getIntegerValue(m_subqueryId);
     context->setResult(retval);
@@ -165,6 +165,12 @@ class CompactingHashMultiMapIndex : public TableIndex
         return ! findKey(searchKey).isEnd();
     }
 
+    bool canPrefetchKeys() const { return true; }
+
+    void prefetchKey(const TableTuple *searchKey) const {
+        m_entries.prefetch(KeyType(searchKey));
+    }
+
     size_t getSize() const { return m_entries.size(); }
 
     int64_t getMemoryEstimate() const
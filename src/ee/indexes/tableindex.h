@@ -418,6 +418,19 @@ public:
 
     virtual bool hasKey(const TableTuple *searchKey) const = 0;
 
+    /**
+     * Return TRUE if prefetchKey can start loading the memory that a
+     * moveToKey on the same key will touch. Callers that probe many keys
+     * use this to decide whether looking ahead at their keys is worth it.
+     */
+    virtual bool canPrefetchKeys() const { return false; }
+
+    /**
+     * Hint that moveToKey will soon be called with this search key, so
+     * that the lookup finds its memory in cache. It has no other effect.
+     */
+    virtual void prefetchKey(const TableTuple *searchKey) const { }
+
     /**
      * This function only supports countable tree index. It returns the counter value
      * equal or greater than the serarchKey. It will return the rank with the searchKey
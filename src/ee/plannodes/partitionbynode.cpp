@@ -32,32 +32,130 @@ PlanNodeType PartitionByPlanNode::getPlanNodeType() const
     return PLAN_NODE_TYPE_PARTITIONBY;
 }
 
+namespace {
+
+WindowFrameBound loadFrameBound(PlannerDomValue frameObj, const char* key)
+{
+    PlannerDomValue boundObj = frameObj.valueForKey(key);
+    std::string type = boundObj.valueForKey("BOUND_TYPE").asStr();
+    WindowFrameBound bound;
+    if (type == "UNBOUNDED_PRECEDING") {
+        bound.m_type = WINDOW_FRAME_BOUND_UNBOUNDED_PRECEDING;
+    } else if (type == "PRECEDING") {
+        bound.m_type = WINDOW_FRAME_BOUND_PRECEDING;
+    } else if (type == "CURRENT_ROW") {
+        bound.m_type = WINDOW_FRAME_BOUND_CURRENT_ROW;
+    } else if (type == "FOLLOWING") {
+        bound.m_type = WINDOW_FRAME_BOUND_FOLLOWING;
+    } else if (type == "UNBOUNDED_FOLLOWING") {
+        bound.m_type = WINDOW_FRAME_BOUND_UNBOUNDED_FOLLOWING;
+    } else {
+        throw SerializableEEException(VOLT_EE_EXCEPTION_TYPE_EEEXCEPTION,
+                                      "PartitionByPlanNode::loadFromJSONObject:"
+                                      " Unknown window frame bound " + type);
+    }
+    if (bound.m_type == WINDOW_FRAME_BOUND_PRECEDING || bound.m_type == WINDOW_FRAME_BOUND_FOLLOWING) {
+        bound.m_offset = boundObj.valueForKey("BOUND_OFFSET").asInt64();
+        if (bound.m_offset < 0) {
+            throw SerializableEEException(VOLT_EE_EXCEPTION_TYPE_EEEXCEPTION,
+                                          "PartitionByPlanNode::loadFromJSONObject:"
+                                          " Negative window frame offset.");
+        }
+    }
+    return bound;
+}
+
+bool hasOffset(const WindowFrameBound& bound)
+{
+    return bound.m_type == WINDOW_FRAME_BOUND_PRECEDING || bound.m_type == WINDOW_FRAME_BOUND_FOLLOWING;
+}
+
+const char* frameBoundToString(const WindowFrameBound& bound)
+{
+    switch (bound.m_type) {
+    case WINDOW_FRAME_BOUND_UNBOUNDED_PRECEDING:
+        return "UNBOUNDED PRECEDING";
+    case WINDOW_FRAME_BOUND_PRECEDING:
+        return "PRECEDING";
+    case WINDOW_FRAME_BOUND_CURRENT_ROW:
+        return "CURRENT ROW";
+    case WINDOW_FRAME_BOUND_FOLLOWING:
+        return "FOLLOWING";
+    default:
+        return "UNBOUNDED FOLLOWING";
+    }
+}
+
+} // anonymous namespace
+
 std::string PartitionByPlanNode::debugInfo(const std::string &spacer) const
 {
     std::ostringstream buffer;
     buffer << "PartitionByPlanNode: ";
     buffer << AggregatePlanNode::debugInfo(spacer);
+    buffer << spacer << "SortColumns[" << m_sortExpressions.size() << "]\n";
+    for (int ctr = 0; ctr < m_sortExpressions.size(); ctr++) {
+        buffer << spacer << "  [" << ctr << "] "
+               << m_sortExpressions[ctr]->debug()
+               << "::" << m_sortDirections[ctr] << "\n";
+    }
+    buffer << spacer << "Frame: "
+           << (m_frameUnit == WINDOW_FRAME_UNIT_ROWS ? "ROWS" : "RANGE") << " BETWEEN ";
+    if (hasOffset(m_frameStart)) {
+        buffer << m_frameStart.m_offset << " ";
+    }
+    buffer << frameBoundToString(m_frameStart) << " AND ";
+    if (hasOffset(m_frameEnd)) {
+        buffer << m_frameEnd.m_offset << " ";
+    }
+    buffer << frameBoundToString(m_frameEnd) << "\n";
     return buffer.str();
 }
 
 void PartitionByPlanNode::loadFromJSONObject(PlannerDomValue obj) {
     AggregatePlanNode::loadFromJSONObject(obj);
-    std::vector<AbstractExpression*>  orderByExpressions;
-    // AggregatePlanNode knows there is an aggregate but
-    // it doesn't know the input expression.  Since we are
-    // coding the order by expression as the input expression
-    // we will need special handling below.
-    assert(m_aggregateInputExpressions.size() == 1);
-    // The Java PartitionByPlanNode puts the order by
-    // expressions in a sensible place.  However, we want
-    // to subvert this sensible behavior by putting the
-    // first and only one in the input expression list for
-    // the only windowed aggregate in this node.  This is
-    // temporizing around our unfortunate inability to
-    // add order by expressions to Agg subobjects in the
-    // executors.
-    AbstractPlanNode::loadSortListFromJSONObject(obj, &orderByExpressions, NULL);
-    assert(orderByExpressions.size() == 1);
-    m_aggregateInputExpressions[0] = orderByExpressions[0];
+    // The window's ORDER BY.  The direction is optional, since the
+    // ranking functions only need to tell peers apart.
+    loadSortListFromJSONObject(obj, &m_sortExpressions, NULL);
+    PlannerDomValue sortColumnsArray = obj.valueForKey("SORT_COLUMNS");
+    for (int i = 0; i < sortColumnsArray.arrayLen(); i++) {
+        PlannerDomValue sortColumn = sortColumnsArray.valueAtIndex(i);
+        if (sortColumn.hasNonNullKey("SORT_DIRECTION")) {
+            m_sortDirections.push_back(stringToSortDirection(sortColumn.valueForKey("SORT_DIRECTION").asStr()));
+        } else {
+            m_sortDirections.push_back(SORT_DIRECTION_TYPE_ASC);
+        }
+    }
+
+    if (obj.hasNonNullKey("WINDOW_FRAME")) {
+        PlannerDomValue frameObj = obj.valueForKey("WINDOW_FRAME");
+        std::string unit = frameObj.valueForKey("FRAME_UNIT").asStr();
+        if (unit == "ROWS") {
+            m_frameUnit = WINDOW_FRAME_UNIT_ROWS;
+        } else if (unit == "RANGE") {
+            m_frameUnit = WINDOW_FRAME_UNIT_RANGE;
+        } else {
+            throw SerializableEEException(VOLT_EE_EXCEPTION_TYPE_EEEXCEPTION,
+                                          "PartitionByPlanNode::loadFromJSONObject:"
+                                          " Unknown window frame unit " + unit);
+        }
+        m_frameStart = loadFrameBound(frameObj, "FRAME_START");
+        m_frameEnd = loadFrameBound(frameObj, "FRAME_END");
+    }
+
+    if (m_frameStart.m_type == WINDOW_FRAME_BOUND_UNBOUNDED_FOLLOWING ||
+        m_frameEnd.m_type == WINDOW_FRAME_BOUND_UNBOUNDED_PRECEDING) {
+        throw SerializableEEException(VOLT_EE_EXCEPTION_TYPE_EEEXCEPTION,
+                                      "PartitionByPlanNode::loadFromJSONObject:"
+                                      " Invalid window frame.");
+    }
+    // A RANGE offset is added to the order by value, so there must be just one and it must be a number.
+    if (m_frameUnit == WINDOW_FRAME_UNIT_RANGE && (hasOffset(m_frameStart) || hasOffset(m_frameEnd))) {
+        if (m_sortExpressions.size() != 1 || ! isNumeric(m_sortExpressions[0]->getValueType())) {
+            throw SerializableEEException(VOLT_EE_EXCEPTION_TYPE_EEEXCEPTION,
+                                          "PartitionByPlanNode::loadFromJSONObject:"
+                                          " A RANGE frame with an offset needs a single numeric order by expression.");
+        }
+    }
 }
 }
@@ -19,17 +19,75 @@
 #include "aggregatenode.h"
 
 namespace voltdb {
+
+/**
+ * The unit in which the bounds of a window frame are measured.
+ * ROWS counts rows from the current row.  RANGE compares the
+ * order by value of each row with that of the current row, so
+ * a CURRENT ROW bound takes in all of the current row's peers.
+ */
+enum WindowFrameUnit {
+    WINDOW_FRAME_UNIT_ROWS,
+    WINDOW_FRAME_UNIT_RANGE
+};
+
+enum WindowFrameBoundType {
+    WINDOW_FRAME_BOUND_UNBOUNDED_PRECEDING,
+    WINDOW_FRAME_BOUND_PRECEDING,
+    WINDOW_FRAME_BOUND_CURRENT_ROW,
+    WINDOW_FRAME_BOUND_FOLLOWING,
+    WINDOW_FRAME_BOUND_UNBOUNDED_FOLLOWING
+};
+
+struct WindowFrameBound {
+    WindowFrameBound(WindowFrameBoundType type = WINDOW_FRAME_BOUND_CURRENT_ROW, int64_t offset = 0)
+        : m_type(type), m_offset(offset) { }
+
+    WindowFrameBoundType m_type;
+    // The number of rows, or the difference in order by value,
+    // for PRECEDING and FOLLOWING bounds.
+    int64_t m_offset;
+};
+
+/**
+ * The plan node for windowed aggregates.  The group by expressions
+ * are the PARTITION BY expressions and the sort columns are the
+ * window's ORDER BY.  The input is sorted on both.
+ *
+ * The aggregates are RANK, DENSE_RANK, or COUNT, SUM, AVG, MIN and
+ * MAX over the window frame.  Without an explicit frame, the frame
+ * runs from the start of the partition to the last peer of the
+ * current row, as the SQL standard specifies.
+ */
 class PartitionByPlanNode : public AggregatePlanNode {
 public:
     PartitionByPlanNode()
-        : AggregatePlanNode(PLAN_NODE_TYPE_HASHAGGREGATE) {
+        : AggregatePlanNode(PLAN_NODE_TYPE_HASHAGGREGATE)
+        , m_frameUnit(WINDOW_FRAME_UNIT_RANGE)
+        , m_frameStart(WINDOW_FRAME_BOUND_UNBOUNDED_PRECEDING)
+        , m_frameEnd(WINDOW_FRAME_BOUND_CURRENT_ROW) {
     }
     ~PartitionByPlanNode();
 
     PlanNodeType getPlanNodeType() const;
     std::string debugInfo(const std::string &spacer) const;
+
+    const std::vector<AbstractExpression*>& getSortExpressions() const { return m_sortExpressions; }
+    const std::vector<SortDirectionType>& getSortDirections() const { return m_sortDirections; }
+
+    WindowFrameUnit getFrameUnit() const { return m_frameUnit; }
+    const WindowFrameBound& getFrameStart() const { return m_frameStart; }
+    const WindowFrameBound& getFrameEnd() const { return m_frameEnd; }
+
 protected:
     void loadFromJSONObject(PlannerDomValue obj);
+
+private:
+    OwningExpressionVector m_sortExpressions;
+    std::vector<SortDirectionType> m_sortDirections;
+    WindowFrameUnit m_frameUnit;
+    WindowFrameBound m_frameStart;
+    WindowFrameBound m_frameEnd;
 };
 }
 #endif /* SRC_EE_PLANNODES_PARTITIONBYNODE_H_ */
@@ -16,6 +16,8 @@
  */
 
 #include "AbstractDRTupleStream.h"
+#include "common/ExportSerializeIo.h"
+#include "common/LZ4Codec.h"
 #include <cassert>
 
 using namespace std;
@@ -31,7 +33,8 @@ AbstractDRTupleStream::AbstractDRTupleStream(int partitionId, int defaultBufferS
           m_secondaryCapacity(SECONDARY_BUFFER_SIZE),
           m_rowTarget(-1),
           m_opened(false),
-          m_txnRowCount(0)
+          m_txnRowCount(0),
+          m_compressBlocks(false)
 {}
 
 // for test purpose
@@ -50,12 +53,47 @@ void AbstractDRTupleStream::setSecondaryCapacity(size_t capacity)
 void AbstractDRTupleStream::pushExportBuffer(StreamBlock *block, bool sync, bool endOfStream)
 {
     if (sync) return;
+    if (m_compressBlocks && block != NULL && block->drEventType() == NOT_A_EVENT) {
+        compressBlock(block);
+    }
     int64_t rowTarget = ExecutorContext::getExecutorContext()->getTopend()->pushDRBuffer(m_partitionId, block);
     if (rowTarget >= 0) {
         m_rowTarget = rowTarget;
     }
 }
 
+/*
+ * Replace the committed contents of a block that is about to leave the EE
+ * with their compressed form, if that is any smaller. Only whole committed
+ * blocks get here, so nothing can roll back into the compressed bytes.
+ */
+void AbstractDRTupleStream::compressBlock(StreamBlock *block)
+{
+    const size_t length = block->offset();
+    if (length <= DR_COMPRESSED_BUFFER_HEADER_SIZE) {
+        return;
+    }
+    const size_t maxLength = LZ4Codec::maxCompressedLength(length);
+    if (m_compressionBuffer.size() < maxLength) {
+        m_compressionBuffer.resize(maxLength);
+    }
+    // give up as soon as the output would not save anything
+    size_t compressedLength = LZ4Codec::compress(block->rawPtr() + block->headerSize(), length,
+                                                 &m_compressionBuffer[0],
+                                                 length - DR_COMPRESSED_BUFFER_HEADER_SIZE - 1);
+    if (compressedLength == 0) {
+        return;
+    }
+
+    char *data = block->rawPtr() + block->headerSize();
+    ExportSerializeOutput header(data, DR_COMPRESSED_BUFFER_HEADER_SIZE);
+    header.writeByte(static_cast<int8_t>(DR_COMPRESSED_BUFFER_MARKER));
+    header.writeByte(static_cast<int8_t>(DR_BUFFER_CODEC_LZ4));
+    header.writeInt(static_cast<int32_t>(length));
+    ::memcpy(data + DR_COMPRESSED_BUFFER_HEADER_SIZE, &m_compressionBuffer[0], compressedLength);
+    block->truncateTo(block->uso() + DR_COMPRESSED_BUFFER_HEADER_SIZE + compressedLength);
+}
+
 // Set m_opened = false first otherwise checkOpenTransaction() may
 // consider the transaction being rolled back as open.
 void AbstractDRTupleStream::rollbackTo(size_t mark, size_t drRowCost)
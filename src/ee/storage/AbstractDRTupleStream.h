@@ -23,11 +23,18 @@
 #include "common/FatalException.hpp"
 #include "storage/TupleStreamBase.h"
 #include <deque>
+#include <vector>
 
 namespace voltdb {
 
 // Extra space to write a StoredProcedureInvocation wrapper in Java without copying
 const int MAGIC_DR_TRANSACTION_PADDING = 78;
+// First byte of a DR buffer whose contents are compressed. It is distinct from
+// every DR protocol version, which is the first byte of an uncompressed buffer.
+// It is followed by the codec (1 byte) and the uncompressed length (4 bytes).
+const uint8_t DR_COMPRESSED_BUFFER_MARKER = 0xFF;
+const uint8_t DR_BUFFER_CODEC_LZ4 = 1;
+const size_t DR_COMPRESSED_BUFFER_HEADER_SIZE = 6;
 const int SECONDARY_BUFFER_SIZE = (45 * 1024 * 1024) + 4096;
 // Use this to indicate uninitialized DR mark
 const size_t INVALID_DR_MARK = SIZE_MAX;
@@ -57,6 +64,11 @@ public:
 
     virtual void setSecondaryCapacity(size_t capacity);
 
+    /** compress buffers when they are handed to the topend */
+    void setBlockCompression(bool compress) {
+        m_compressBlocks = compress;
+    }
+
     void setLastCommittedSequenceNumber(int64_t sequenceNumber);
 
     /**
@@ -121,6 +133,11 @@ protected:
     size_t m_txnRowCount;
 
 private:
+    void compressBlock(StreamBlock *block);
+
+    bool m_compressBlocks;
+    std::vector<char> m_compressionBuffer;
+
     // return true if stream state was switched from close to open
     virtual bool transactionChecks(int64_t lastCommittedSpHandle, int64_t spHandle, int64_t uniqueId) = 0;
 };
@@ -486,7 +486,7 @@ bool handleConflict(VoltDBEngine *engine, PersistentTable *drTable, Pool *pool,
 
 } //end of anonymous namespace
 
-BinaryLogSink::BinaryLogSink() {}
+BinaryLogSink::BinaryLogSink() : m_lastTableHandle(0), m_lastTable(NULL) {}
 
 int64_t BinaryLogSink::applyTxn(ReferenceSerializeInputLE *taskInfo,
                                 boost::unordered_map<int64_t, PersistentTable*> &tables,
@@ -519,11 +519,16 @@ int64_t BinaryLogSink::applyTxn(ReferenceSerializeInputLE *taskInfo,
             UniqueId::isMpUniqueId(uniqueId) &&
             !engine->isLocalSite(partitionHash);
     }
+
+    // The table map may have changed since the last transaction
+    m_lastTable = NULL;
+    m_records.clear();
+
     // Read the whole txn since there is only one version number at the beginning
     type = static_cast<DRRecordType>(taskInfo->readByte());
     while (type != DR_RECORD_END_TXN) {
-        rowCount += apply(taskInfo, type, tables, pool, engine, remoteClusterId,
-                txnStart, sequenceNumber, uniqueId, skipWrongHashRows);
+        m_records.push_back(PendingRecord());
+        readRecord(taskInfo, type, skipWrongHashRows, m_records.back());
         type = static_cast<DRRecordType>(taskInfo->readByte());
         if (type == DR_RECORD_HASH_DELIMITER) {
             assert(isMultiHash);
@@ -541,32 +546,165 @@ int64_t BinaryLogSink::applyTxn(ReferenceSerializeInputLE *taskInfo,
     uint32_t checksum = taskInfo->readInt();
     validateChecksum(checksum, txnStart, taskInfo->getRawPointer());
 
+    findFoldableRecords();
+
+    for (size_t i = 0; i < m_records.size(); ++i) {
+        const PendingRecord &record = m_records[i];
+        if (record.folded) {
+            rowCount += static_cast<int64_t>(rowCostForDRRecord(record.type));
+            continue;
+        }
+        if (record.foldPartner >= 0 && foldInsert(record, findTable(record, tables), pool)) {
+            m_records[record.foldPartner].folded = true;
+            rowCount += static_cast<int64_t>(rowCostForDRRecord(record.type));
+            continue;
+        }
+        rowCount += apply(record, tables, pool, engine, remoteClusterId, sequenceNumber, uniqueId);
+    }
+
     return rowCount;
 }
 
-int64_t BinaryLogSink::apply(ReferenceSerializeInputLE *taskInfo, const DRRecordType type,
-                             boost::unordered_map<int64_t, PersistentTable*> &tables,
-                             Pool *pool, VoltDBEngine *engine, int32_t remoteClusterId,
-                             const char *txnStart, int64_t sequenceNumber, int64_t uniqueId, bool skipRow) {
+void BinaryLogSink::readRecord(ReferenceSerializeInputLE *taskInfo, const DRRecordType type,
+                               bool skipRow, PendingRecord &record) {
+    record.type = type;
+    record.tableHandle = 0;
+    record.rowData = NULL;
+    record.rowLength = 0;
+    record.newRowData = NULL;
+    record.newRowLength = 0;
+    record.skipRow = skipRow;
+    record.foldPartner = -1;
+    record.folded = false;
+
     switch (type) {
-    case DR_RECORD_INSERT: {
-        int64_t tableHandle = taskInfo->readLong();
-        int32_t rowLength = taskInfo->readInt();
-        const char *rowData = reinterpret_cast<const char *>(taskInfo->getRawPointer(rowLength));
-        if (skipRow) {
-            break;
+    case DR_RECORD_INSERT:
+    case DR_RECORD_DELETE: {
+        record.tableHandle = taskInfo->readLong();
+        record.rowLength = taskInfo->readInt();
+        record.rowData = reinterpret_cast<const char *>(taskInfo->getRawPointer(record.rowLength));
+        break;
+    }
+    case DR_RECORD_UPDATE: {
+        record.tableHandle = taskInfo->readLong();
+        record.rowLength = taskInfo->readInt();
+        record.rowData = reinterpret_cast<const char*>(taskInfo->getRawPointer(record.rowLength));
+        record.newRowLength = taskInfo->readInt();
+        record.newRowData = reinterpret_cast<const char*>(taskInfo->getRawPointer(record.newRowLength));
+        break;
+    }
+    case DR_RECORD_DELETE_BY_INDEX: {
+        throwSerializableEEException("Delete by index is not supported for DR");
+    }
+    case DR_RECORD_UPDATE_BY_INDEX: {
+        throwSerializableEEException("Update by index is not supported for DR");
+    }
+    case DR_RECORD_TRUNCATE_TABLE: {
+        record.tableHandle = taskInfo->readLong();
+        record.tableName = taskInfo->readTextString();
+        // ignore the value of skipRow for truncate table record
+        record.skipRow = false;
+        break;
+    }
+    case DR_RECORD_BEGIN_TXN: {
+        throwFatalException("Unexpected BEGIN_TXN before END_TXN");
+        break;
+    }
+    default:
+        throwFatalException("Unrecognized DR record type %d", type);
+        break;
+    }
+}
+
+PersistentTable *BinaryLogSink::findTable(const PendingRecord &record,
+                                          boost::unordered_map<int64_t, PersistentTable*> &tables) {
+    // Records of a transaction tend to come in runs on the same table
+    if (m_lastTable != NULL && m_lastTableHandle == record.tableHandle) {
+        return m_lastTable;
+    }
+    boost::unordered_map<int64_t, PersistentTable*>::iterator tableIter = tables.find(record.tableHandle);
+    if (tableIter == tables.end()) {
+        if (record.type == DR_RECORD_TRUNCATE_TABLE) {
+            throwSerializableEEException("Unable to find table %s hash %jd while applying binary log for truncate record",
+                                         record.tableName.c_str(), (intmax_t)record.tableHandle);
         }
+        throwSerializableEEException("Unable to find table hash %jd while applying a binary log %s record",
+                                     (intmax_t)record.tableHandle,
+                                     record.type == DR_RECORD_INSERT ? "insert" :
+                                     (record.type == DR_RECORD_DELETE ? "delete" : "update"));
+    }
+    m_lastTableHandle = record.tableHandle;
+    m_lastTable = tableIter->second;
+    return m_lastTable;
+}
 
-        boost::unordered_map<int64_t, PersistentTable*>::iterator tableIter = tables.find(tableHandle);
-        if (tableIter == tables.end()) {
-            throwSerializableEEException("Unable to find table hash %jd while applying a binary log insert record",
-                                         (intmax_t)tableHandle);
+/*
+ * Pair each INSERT with a DELETE of the identical row that is the next
+ * record applied to the same table. Such a pair leaves the table as it was,
+ * so both records can be dropped as long as the insert would have succeeded,
+ * which foldInsert() checks when the pair is reached.
+ */
+void BinaryLogSink::findFoldableRecords() {
+    boost::unordered_map<int64_t, int32_t> openInserts;
+    for (int32_t i = 0; i < static_cast<int32_t>(m_records.size()); ++i) {
+        PendingRecord &record = m_records[i];
+        if (record.skipRow) {
+            continue;
+        }
+        if ( ! openInserts.empty()) {
+            boost::unordered_map<int64_t, int32_t>::iterator openIter = openInserts.find(record.tableHandle);
+            if (openIter != openInserts.end()) {
+                PendingRecord &insert = m_records[openIter->second];
+                if (record.type == DR_RECORD_DELETE &&
+                    record.rowLength == insert.rowLength &&
+                    ::memcmp(record.rowData, insert.rowData, record.rowLength) == 0) {
+                    insert.foldPartner = i;
+                }
+                openInserts.erase(openIter);
+            }
+        }
+        if (record.type == DR_RECORD_INSERT) {
+            openInserts[record.tableHandle] = i;
         }
-        PersistentTable *table = tableIter->second;
+    }
+}
+
+bool BinaryLogSink::foldInsert(const PendingRecord &record, PersistentTable *table, Pool *pool) {
+    if (table->uniqueIndexCount() == 0) {
+        return true;
+    }
+    // Checking that the insert would succeed is only cheap and exact when
+    // the primary key is the sole unique index.
+    if (table->uniqueIndexCount() != 1 || table->primaryKeyIndex() == NULL) {
+        return false;
+    }
+
+    TableTuple tempTuple = table->tempTuple();
+    ReferenceSerializeInputLE rowInput(record.rowData, record.rowLength);
+    try {
+        tempTuple.deserializeFromDR(rowInput, pool);
+    } catch (SerializableEEException &e) {
+        e.appendContextToMessage(" DR binary log insert on table " + table->name());
+        throw;
+    }
+    return table->lookupTupleForDR(tempTuple).isNullTuple();
+}
+
+int64_t BinaryLogSink::apply(const PendingRecord &record,
+                             boost::unordered_map<int64_t, PersistentTable*> &tables,
+                             Pool *pool, VoltDBEngine *engine, int32_t remoteClusterId,
+                             int64_t sequenceNumber, int64_t uniqueId) {
+    const DRRecordType type = record.type;
+    if (record.skipRow) {
+        return static_cast<int64_t>(rowCostForDRRecord(type));
+    }
+    PersistentTable *table = findTable(record, tables);
 
+    switch (type) {
+    case DR_RECORD_INSERT: {
         TableTuple tempTuple = table->tempTuple();
 
-        ReferenceSerializeInputLE rowInput(rowData, rowLength);
+        ReferenceSerializeInputLE rowInput(record.rowData, record.rowLength);
         try {
             tempTuple.deserializeFromDR(rowInput, pool);
         } catch (SerializableEEException &e) {
@@ -588,23 +726,9 @@ int64_t BinaryLogSink::apply(ReferenceSerializeInputLE *taskInfo, const DRRecord
         break;
     }
     case DR_RECORD_DELETE: {
-        int64_t tableHandle = taskInfo->readLong();
-        int32_t rowLength = taskInfo->readInt();
-        const char *rowData = reinterpret_cast<const char *>(taskInfo->getRawPointer(rowLength));
-        if (skipRow) {
-            break;
-        }
-
-        boost::unordered_map<int64_t, PersistentTable*>::iterator tableIter = tables.find(tableHandle);
-        if (tableIter == tables.end()) {
-            throwSerializableEEException("Unable to find table hash %jd while applying a binary log delete record",
-                                         (intmax_t)tableHandle);
-        }
-        PersistentTable *table = tableIter->second;
-
         TableTuple tempTuple = table->tempTuple();
 
-        ReferenceSerializeInputLE rowInput(rowData, rowLength);
+        ReferenceSerializeInputLE rowInput(record.rowData, record.rowLength);
         try {
             tempTuple.deserializeFromDR(rowInput, pool);
         } catch (SerializableEEException &e) {
@@ -641,25 +765,9 @@ int64_t BinaryLogSink::apply(ReferenceSerializeInputLE *taskInfo, const DRRecord
         break;
     }
     case DR_RECORD_UPDATE: {
-        int64_t tableHandle = taskInfo->readLong();
-        int32_t oldRowLength = taskInfo->readInt();
-        const char *oldRowData = reinterpret_cast<const char*>(taskInfo->getRawPointer(oldRowLength));
-        int32_t newRowLength = taskInfo->readInt();
-        const char *newRowData = reinterpret_cast<const char*>(taskInfo->getRawPointer(newRowLength));
-        if (skipRow) {
-            break;
-        }
-
-        boost::unordered_map<int64_t, PersistentTable*>::iterator tableIter = tables.find(tableHandle);
-        if (tableIter == tables.end()) {
-            throwSerializableEEException("Unable to find table hash %jd while applying a binary log update record",
-                                         (intmax_t)tableHandle);
-        }
-        PersistentTable *table = tableIter->second;
-
         TableTuple tempTuple = table->tempTuple();
 
-        ReferenceSerializeInputLE oldRowInput(oldRowData, oldRowLength);
+        ReferenceSerializeInputLE oldRowInput(record.rowData, record.rowLength);
         try {
             tempTuple.deserializeFromDR(oldRowInput, pool);
         } catch (SerializableEEException &e) {
@@ -673,7 +781,7 @@ int64_t BinaryLogSink::apply(ReferenceSerializeInputLE *taskInfo, const DRRecord
         expectedTuple.move(expectedData.get());
         expectedTuple.copyForPersistentInsert(tempTuple, pool);
 
-        ReferenceSerializeInputLE newRowInput(newRowData, newRowLength);
+        ReferenceSerializeInputLE newRowInput(record.newRowData, record.newRowLength);
         try {
             tempTuple.deserializeFromDR(newRowInput, pool);
         } catch (SerializableEEException &e) {
@@ -726,31 +834,10 @@ int64_t BinaryLogSink::apply(ReferenceSerializeInputLE *taskInfo, const DRRecord
         }
         break;
     }
-    case DR_RECORD_DELETE_BY_INDEX: {
-        throwSerializableEEException("Delete by index is not supported for DR");
-    }
-    case DR_RECORD_UPDATE_BY_INDEX: {
-        throwSerializableEEException("Update by index is not supported for DR");
-    }
     case DR_RECORD_TRUNCATE_TABLE: {
-        int64_t tableHandle = taskInfo->readLong();
-        std::string tableName = taskInfo->readTextString();
-        // ignore the value of skipRow for truncate table record
-
-        boost::unordered_map<int64_t, PersistentTable*>::iterator tableIter = tables.find(tableHandle);
-        if (tableIter == tables.end()) {
-            throwSerializableEEException("Unable to find table %s hash %jd while applying binary log for truncate record",
-                                         tableName.c_str(), (intmax_t)tableHandle);
-        }
-
-        PersistentTable *table = tableIter->second;
-
         table->truncateTable(engine, true);
-
-        break;
-    }
-    case DR_RECORD_BEGIN_TXN: {
-        throwFatalException("Unexpected BEGIN_TXN before END_TXN");
+        // truncation may have swapped in a new table object
+        m_lastTable = NULL;
         break;
     }
     default:
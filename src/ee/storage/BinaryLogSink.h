@@ -23,6 +23,9 @@
 #include <boost/unordered_map.hpp>
 #include <boost/shared_ptr.hpp>
 
+#include <string>
+#include <vector>
+
 namespace voltdb {
 
 class PersistentTable;
@@ -41,10 +44,41 @@ public:
                      const char *txnStart);
 
 private:
-    int64_t apply(ReferenceSerializeInputLE *taskInfo, const DRRecordType type,
+    /*
+     * A record of the transaction being applied, decoded ahead of time so
+     * that the whole transaction can be inspected before storage is touched.
+     */
+    struct PendingRecord {
+        DRRecordType type;
+        int64_t tableHandle;
+        const char *rowData;
+        int32_t rowLength;
+        const char *newRowData;
+        int32_t newRowLength;
+        std::string tableName;
+        bool skipRow;
+        // index of a later DELETE of this INSERT's row, or -1
+        int32_t foldPartner;
+        bool folded;
+    };
+
+    void readRecord(ReferenceSerializeInputLE *taskInfo, const DRRecordType type,
+                    bool skipRow, PendingRecord &record);
+    void findFoldableRecords();
+    PersistentTable *findTable(const PendingRecord &record,
+                               boost::unordered_map<int64_t, PersistentTable*> &tables);
+    bool foldInsert(const PendingRecord &record, PersistentTable *table, Pool *pool);
+    int64_t apply(const PendingRecord &record,
                   boost::unordered_map<int64_t, PersistentTable*> &tables,
                   Pool *pool, VoltDBEngine *engine, int32_t remoteClusterId,
-                  const char *txnStart, int64_t sequenceNumber, int64_t uniqueId, bool skipRow);
+                  int64_t sequenceNumber, int64_t uniqueId);
+
+    // reused across transactions to avoid reallocating
+    std::vector<PendingRecord> m_records;
+    // last table resolved while applying, to skip the map lookup for
+    // consecutive records on the same table
+    int64_t m_lastTableHandle;
+    PersistentTable *m_lastTable;
 };
 
 
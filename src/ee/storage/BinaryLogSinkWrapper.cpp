@@ -19,6 +19,7 @@
 
 #include "storage/DRTupleStream.h"
 #include "storage/CompatibleDRTupleStream.h"
+#include "common/LZ4Codec.h"
 #include "common/serializeio.h"
 
 using namespace std;
@@ -27,8 +28,37 @@ using namespace voltdb;
 int64_t BinaryLogSinkWrapper::apply(const char* taskParams, boost::unordered_map<int64_t, PersistentTable*> &tables,
                                     Pool *pool, VoltDBEngine *engine, int32_t remoteClusterId)
 {
-    ReferenceSerializeInputLE taskInfo(taskParams + 4, ntohl(*reinterpret_cast<const int32_t*>(taskParams)));
+    const int32_t length = ntohl(*reinterpret_cast<const int32_t*>(taskParams));
+    const char *data = taskParams + 4;
+    if (length > static_cast<int32_t>(DR_COMPRESSED_BUFFER_HEADER_SIZE) &&
+        static_cast<uint8_t>(*data) == DR_COMPRESSED_BUFFER_MARKER) {
+        ReferenceSerializeInputLE header(data, DR_COMPRESSED_BUFFER_HEADER_SIZE);
+        header.readByte();
+        const uint8_t codec = header.readByte();
+        const int32_t uncompressedLength = header.readInt();
+        if (codec != DR_BUFFER_CODEC_LZ4) {
+            throwFatalException("Unsupported DR buffer codec %d", codec);
+        }
+        if (m_decompressionBuffer.size() < static_cast<size_t>(uncompressedLength)) {
+            m_decompressionBuffer.resize(uncompressedLength);
+        }
+        if ( ! LZ4Codec::decompress(data + DR_COMPRESSED_BUFFER_HEADER_SIZE,
+                                    length - DR_COMPRESSED_BUFFER_HEADER_SIZE,
+                                    &m_decompressionBuffer[0], uncompressedLength)) {
+            throwFatalException("Corrupt compressed DR buffer of length %d", length);
+        }
+        ReferenceSerializeInputLE taskInfo(&m_decompressionBuffer[0], uncompressedLength);
+        return applyTxns(taskInfo, tables, pool, engine, remoteClusterId);
+    }
 
+    ReferenceSerializeInputLE taskInfo(data, length);
+    return applyTxns(taskInfo, tables, pool, engine, remoteClusterId);
+}
+
+int64_t BinaryLogSinkWrapper::applyTxns(ReferenceSerializeInputLE &taskInfo,
+                                        boost::unordered_map<int64_t, PersistentTable*> &tables,
+                                        Pool *pool, VoltDBEngine *engine, int32_t remoteClusterId)
+{
     int64_t __attribute__ ((unused)) uniqueId = 0;
     int64_t __attribute__ ((unused)) sequenceNumber = -1;
 
@@ -23,6 +23,8 @@
 #include <boost/unordered_map.hpp>
 #include <boost/shared_ptr.hpp>
 
+#include <vector>
+
 namespace voltdb {
 
 class PersistentTable;
@@ -39,8 +41,13 @@ public:
     int64_t apply(const char* taskParams, boost::unordered_map<int64_t, PersistentTable*> &tables,
                   Pool *pool, VoltDBEngine *engine, int32_t remoteClusterId);
 private:
+    int64_t applyTxns(ReferenceSerializeInputLE &taskInfo, boost::unordered_map<int64_t, PersistentTable*> &tables,
+                      Pool *pool, VoltDBEngine *engine, int32_t remoteClusterId);
+
     BinaryLogSink m_sink;
     CompatibleBinaryLogSink m_compatibleSink;
+    // holds the contents of a compressed buffer while it is applied
+    std::vector<char> m_decompressionBuffer;
 };
 
 
@@ -234,9 +234,7 @@ bool ElasticContext::notifyTupleUpdate(TableTuple &tuple)
 bool ElasticContext::notifyTupleDelete(TableTuple &tuple)
 {
     if (m_indexActive) {
-        if (m_surgeon.indexHas(tuple)) {
-            m_surgeon.indexRemove(tuple);
-        }
+        m_surgeon.indexRemove(tuple);
     }
     return true;
 }
@@ -250,8 +248,7 @@ void ElasticContext::notifyTupleMovement(TBPtr sourceBlock,
                                          TableTuple &targetTuple)
 {
     if (m_indexActive) {
-        if (m_surgeon.indexHas(sourceTuple)) {
-            m_surgeon.indexRemove(sourceTuple);
+        if (m_surgeon.indexRemove(sourceTuple)) {
             // If the tuple is pending delete, it's held on by COW but
             // shouldn't be accessible anymore. So don't add it back to
             // elastic index.
@@ -389,12 +389,7 @@ inline bool ElasticIndex::add(const PersistentTable &table, const TableTuple &tu
  */
 inline bool ElasticIndex::add(const ElasticIndexKey &key)
 {
-    bool inserted = false;
-    if (!exists(key)) {
-        inserted = insert(key).second;
-        assert(inserted);
-    }
-    return inserted;
+    return insert(key).second;
 }
 
 /**
@@ -403,12 +398,8 @@ inline bool ElasticIndex::add(const ElasticIndexKey &key)
  */
 inline bool ElasticIndex::remove(const PersistentTable &table, const TableTuple &tuple)
 {
-    bool removed = false;
-    ElasticIndexKey key = generateKey(table, tuple);
-    if (exists(key)) {
-        removed = this->erase(key);
-    }
-    return removed;
+    // Keys are unique, so a single descent finds and erases the entry.
+    return erase_one(generateKey(table, tuple));
 }
 
 /**
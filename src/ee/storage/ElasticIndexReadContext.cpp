@@ -15,6 +15,8 @@
  * along with VoltDB.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <boost/foreach.hpp>
 #include <boost/lexical_cast.hpp>
 #include "common/MiscUtil.h"
 #include "common/TupleOutputStream.h"
@@ -231,10 +233,21 @@ void ElasticIndexReadContext::deleteStreamedTuples()
     // Delete the indexed tuples that were streamed.
     // Undo token release will cause the index to delete the corresponding items
     // via notifications.
+    // The index is in hash order, which scatters the tuples over all the
+    // blocks. Deleting in address order instead works through one block at
+    // a time, both here and when the deletes are released.
     DRTupleStreamDisableGuard guard(ExecutorContext::getExecutorContext());
+    std::vector<char*> tupleAddresses;
     m_iter->reset();
     TableTuple tuple;
     while (m_iter->next(tuple)) {
+        tupleAddresses.push_back(tuple.address());
+    }
+    std::sort(tupleAddresses.begin(), tupleAddresses.end());
+
+    tuple = TableTuple(getTable().schema());
+    BOOST_FOREACH (char *address, tupleAddresses) {
+        tuple.move(address);
         if (!tuple.isPendingDelete()) {
             m_surgeon.deleteTuple(tuple);
         }
@@ -25,6 +25,8 @@
 #include "common/ExportSerializeIo.h"
 #include "common/executorcontext.hpp"
 
+#include <boost/foreach.hpp>
+
 #include <cstdio>
 #include <limits>
 #include <iostream>
@@ -38,11 +40,49 @@ using namespace voltdb;
 
 const int METADATA_COL_CNT = 6;
 
+// Fixed-width types whose export encoding is exactly their tuple storage.
+static inline bool isFixedWidthExportType(ValueType type)
+{
+    switch (type) {
+    case VALUE_TYPE_TINYINT:
+    case VALUE_TYPE_SMALLINT:
+    case VALUE_TYPE_INTEGER:
+    case VALUE_TYPE_BIGINT:
+    case VALUE_TYPE_TIMESTAMP:
+    case VALUE_TYPE_DOUBLE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Same null tests as NValue::initFromTupleStorage, without building an NValue.
+static inline bool isFixedWidthColumnNull(ValueType type, const char *storage)
+{
+    switch (type) {
+    case VALUE_TYPE_TINYINT:
+        return *reinterpret_cast<const int8_t*>(storage) == INT8_NULL;
+    case VALUE_TYPE_SMALLINT:
+        return *reinterpret_cast<const int16_t*>(storage) == INT16_NULL;
+    case VALUE_TYPE_INTEGER:
+        return *reinterpret_cast<const int32_t*>(storage) == INT32_NULL;
+    case VALUE_TYPE_BIGINT:
+    case VALUE_TYPE_TIMESTAMP:
+        return *reinterpret_cast<const int64_t*>(storage) == INT64_NULL;
+    case VALUE_TYPE_DOUBLE:
+        return *reinterpret_cast<const double*>(storage) <= DOUBLE_NULL;
+    default:
+        assert(false);
+        return false;
+    }
+}
+
 ExportTupleStream::ExportTupleStream(CatalogId partitionId,
                                        int64_t siteId)
     : TupleStreamBase(EL_BUFFER_SIZE),
       m_partitionId(partitionId), m_siteId(siteId),
-      m_signature(""), m_generation(0)
+      m_signature(""), m_generation(0),
+      m_compiledSchema(NULL), m_rowHeaderSz(0), m_fixedMaxSz(0)
 {}
 
 void ExportTupleStream::setSignatureAndGeneration(std::string signature, int64_t generation) {
@@ -93,9 +133,18 @@ size_t ExportTupleStream::appendTuple(int64_t lastCommittedSpHandle,
                                        TableTuple &tuple,
                                        ExportTupleStream::Type type)
 {
-    size_t rowHeaderSz = 0;
-    size_t tupleMaxLength = 0;
+    return appendTuples(lastCommittedSpHandle, spHandle, seqNo, uniqueId, timestamp, &tuple, 1, type);
+}
 
+size_t ExportTupleStream::appendTuples(int64_t lastCommittedSpHandle,
+                                        int64_t spHandle,
+                                        int64_t seqNo,
+                                        int64_t uniqueId,
+                                        int64_t timestamp,
+                                        TableTuple *tuples,
+                                        size_t tupleCount,
+                                        ExportTupleStream::Type type)
+{
     // Transaction IDs for transactions applied to this tuple stream
     // should always be moving forward in time.
     if (spHandle < m_openSpHandle)
@@ -111,9 +160,24 @@ size_t ExportTupleStream::appendTuple(int64_t lastCommittedSpHandle,
     //but it is fine since export isn't currently using the info
     commit(lastCommittedSpHandle, spHandle, uniqueId, false, false);
 
+    const size_t startingUso = m_uso;
+    for (size_t ii = 0; ii < tupleCount; ++ii) {
+        appendTupleToCurrentBlock(tuples[ii], spHandle, seqNo + ii, timestamp, type);
+    }
+//    std::cout << "Appending " << tupleCount << " rows to uso " << startingUso << std::endl;
+    return startingUso;
+}
+
+size_t ExportTupleStream::appendTupleToCurrentBlock(TableTuple &tuple,
+                                                     int64_t spHandle,
+                                                     int64_t seqNo,
+                                                     int64_t timestamp,
+                                                     ExportTupleStream::Type type)
+{
+    size_t rowHeaderSz = 0;
+
     // Compute the upper bound on bytes required to serialize tuple.
-    // exportxxx: can memoize this calculation.
-    tupleMaxLength = computeOffsets(tuple, &rowHeaderSz);
+    size_t tupleMaxLength = computeOffsets(tuple, &rowHeaderSz);
 
     if (!m_currBlock) {
         extendBufferChain(m_defaultCapacity);
@@ -123,35 +187,54 @@ size_t ExportTupleStream::appendTuple(int64_t lastCommittedSpHandle,
         extendBufferChain(tupleMaxLength);
     }
 
+    char *rowStart = m_currBlock->mutableDataPtr();
+
     // initialize the full row header to 0. This also
     // has the effect of setting each column non-null.
-    ::memset(m_currBlock->mutableDataPtr(), 0, rowHeaderSz);
+    ::memset(rowStart, 0, rowHeaderSz);
 
     // the nullarray lives in rowheader after the 4 byte header length prefix
-    uint8_t *nullArray =
-      reinterpret_cast<uint8_t*>(m_currBlock->mutableDataPtr() + sizeof (int32_t));
+    uint8_t *nullArray = reinterpret_cast<uint8_t*>(rowStart + sizeof (int32_t));
 
     // position the serializer after the full rowheader
-    ExportSerializeOutput io(m_currBlock->mutableDataPtr() + rowHeaderSz,
-                             m_currBlock->remaining() - rowHeaderSz);
-
-    // write metadata columns
-    io.writeLong(spHandle);
-    io.writeLong(timestamp);
-    io.writeLong(seqNo);
-    io.writeLong(m_partitionId);
-    io.writeLong(m_siteId);
+    ExportSerializeOutput io(rowStart + rowHeaderSz, m_currBlock->remaining() - rowHeaderSz);
 
+    // write metadata columns in one go; the layout matches the
+    // individual writeLong/writeByte calls it replaces
+    char metadata[(sizeof (int64_t) * 5) + 1];
+    const int64_t partitionId = m_partitionId;
+    ::memcpy(metadata, &spHandle, sizeof (int64_t));
+    ::memcpy(metadata + 8, &timestamp, sizeof (int64_t));
+    ::memcpy(metadata + 16, &seqNo, sizeof (int64_t));
+    ::memcpy(metadata + 24, &partitionId, sizeof (int64_t));
+    ::memcpy(metadata + 32, &m_siteId, sizeof (int64_t));
     // use 1 for INSERT EXPORT op, 0 for DELETE EXPORT op
-    io.writeByte(static_cast<int8_t>((type == INSERT) ? 1L : 0L));
+    metadata[40] = static_cast<char>((type == INSERT) ? 1 : 0);
+    io.writeBytes(metadata, sizeof (metadata));
 
     // write the tuple's data
-    tuple.serializeToExport(io, METADATA_COL_CNT, nullArray);
+    const char *tupleData = tuple.address() + TUPLE_HEADER_SIZE;
+    BOOST_FOREACH(const ColumnStep &step, m_steps) {
+        if (step.fixedWidthRun) {
+            serializeFixedWidthRun(step, tupleData, io, nullArray);
+        }
+        else {
+            int colIndex = step.firstColumn;
+            const NValue value = tuple.getNValue(colIndex);
+            colIndex += METADATA_COL_CNT;
+            if (value.isNull()) {
+                nullArray[colIndex >> 3] |= static_cast<uint8_t>(0x80 >> (colIndex & 7));
+            }
+            else {
+                value.serializeToExport_withoutNull(io);
+            }
+        }
+    }
 
     // write the row size in to the row header
     // rowlength does not include the 4 byte row header
     // but does include the null array.
-    ExportSerializeOutput hdr(m_currBlock->mutableDataPtr(), 4);
+    ExportSerializeOutput hdr(rowStart, 4);
     hdr.writeInt((int32_t)(io.position()) + (int32_t)rowHeaderSz - 4);
 
     // update m_offset
@@ -160,31 +243,125 @@ size_t ExportTupleStream::appendTuple(int64_t lastCommittedSpHandle,
     // update uso.
     const size_t startingUso = m_uso;
     m_uso += (rowHeaderSz + io.position());
-//    std::cout << "Appending row " << rowHeaderSz + io.position() << " to uso " << m_currBlock->uso() << " offset " << m_currBlock->offset() << std::endl;
     return startingUso;
 }
 
-size_t
-ExportTupleStream::computeOffsets(TableTuple &tuple,
-                                   size_t *rowHeaderSz)
+/*
+ * Copy a run of fixed-width columns. The common case of no nulls is a
+ * single memcpy; otherwise the non-null columns are copied one by one and
+ * the null ones are flagged in the null array.
+ */
+void ExportTupleStream::serializeFixedWidthRun(const ColumnStep &run,
+                                               const char *tupleData,
+                                               ExportSerializeOutput &io,
+                                               uint8_t *nullArray) const
 {
+    const char *runData = tupleData + run.storageOffset;
+    const int endColumn = run.firstColumn + run.columnCount;
+    const TupleSchema *schema = m_compiledSchema;
+    bool hasNull = false;
+    for (int colIndex = run.firstColumn; colIndex < endColumn; ++colIndex) {
+        const TupleSchema::ColumnInfo *columnInfo = schema->getColumnInfo(colIndex);
+        if (isFixedWidthColumnNull(columnInfo->getVoltType(), tupleData + columnInfo->offset)) {
+            hasNull = true;
+            break;
+        }
+    }
+    if (!hasNull) {
+        io.writeBytes(runData, run.length);
+        return;
+    }
+    for (int colIndex = run.firstColumn; colIndex < endColumn; ++colIndex) {
+        const TupleSchema::ColumnInfo *columnInfo = schema->getColumnInfo(colIndex);
+        const char *columnData = tupleData + columnInfo->offset;
+        if (isFixedWidthColumnNull(columnInfo->getVoltType(), columnData)) {
+            int bit = colIndex + METADATA_COL_CNT;
+            nullArray[bit >> 3] |= static_cast<uint8_t>(0x80 >> (bit & 7));
+        }
+        else {
+            io.writeBytes(columnData, columnInfo->length);
+        }
+    }
+}
+
+void ExportTupleStream::compileSchema(const TupleSchema *schema)
+{
+    m_compiledSchema = schema;
+    m_steps.clear();
+    m_varLengthColumns.clear();
+
     // round-up columncount to next multiple of 8 and divide by 8
-    int columnCount = tuple.sizeInValues() + METADATA_COL_CNT;
+    int columnCount = schema->columnCount() + METADATA_COL_CNT;
     int nullMaskLength = ((columnCount + 7) & -8) >> 3;
 
     // row header is 32-bit length of row plus null mask
-    *rowHeaderSz = sizeof (int32_t) + nullMaskLength;
+    m_rowHeaderSz = sizeof (int32_t) + nullMaskLength;
 
     // metadata column width: 5 int64_ts plus CHAR(1).
-    size_t metadataSz = (sizeof (int64_t) * 5) + 1;
+    m_fixedMaxSz = m_rowHeaderSz + (sizeof (int64_t) * 5) + 1;
+
+    for (int colIndex = 0; colIndex < schema->columnCount(); ++colIndex) {
+        const TupleSchema::ColumnInfo *columnInfo = schema->getColumnInfo(colIndex);
+        ValueType columnType = columnInfo->getVoltType();
+        if (isFixedWidthExportType(columnType)) {
+            m_fixedMaxSz += columnInfo->length;
+            if (!m_steps.empty() && m_steps.back().fixedWidthRun &&
+                m_steps.back().storageOffset + m_steps.back().length == columnInfo->offset) {
+                ++m_steps.back().columnCount;
+                m_steps.back().length += columnInfo->length;
+                continue;
+            }
+            ColumnStep run = { true, colIndex, 1, columnInfo->offset, columnInfo->length };
+            m_steps.push_back(run);
+            continue;
+        }
+        ColumnStep generic = { false, colIndex, 1, columnInfo->offset, columnInfo->length };
+        m_steps.push_back(generic);
+        switch (columnType) {
+        case VALUE_TYPE_VARCHAR:
+        case VALUE_TYPE_VARBINARY:
+        case VALUE_TYPE_GEOGRAPHY:
+            m_varLengthColumns.push_back(colIndex);
+            break;
+        case VALUE_TYPE_DECIMAL:
+            //1-byte scale, 1-byte precision, 16 bytes all the time right now
+            m_fixedMaxSz += 18;
+            break;
+        case VALUE_TYPE_POINT:
+            m_fixedMaxSz += sizeof (GeographyPointValue);
+            break;
+        default:
+            throwDynamicSQLException(
+                    "Unknown ValueType %s found during Export serialization.",
+                    valueToString(columnType).c_str() );
+            break;
+        }
+    }
+}
 
-    // returns 0 if corrupt tuple detected
-    size_t dataSz = tuple.maxExportSerializationSize();
-    if (dataSz == 0) {
-        throwFatalException("Invalid tuple passed to computeTupleMaxLength. Crashing System.");
+size_t
+ExportTupleStream::computeOffsets(TableTuple &tuple,
+                                   size_t *rowHeaderSz)
+{
+    const TupleSchema *schema = tuple.getSchema();
+    // The plan is keyed by schema; tuples appended to a stream normally
+    // all share the schema of its table.
+    if (schema != m_compiledSchema) {
+        compileSchema(schema);
     }
+    *rowHeaderSz = m_rowHeaderSz;
 
-    return *rowHeaderSz + metadataSz + dataSz;
+    size_t maxLength = m_fixedMaxSz;
+    BOOST_FOREACH(int colIndex, m_varLengthColumns) {
+        // 32 bit length preceding the value; null columns take no bytes
+        const NValue value = tuple.getNValue(colIndex);
+        if (!value.isNull()) {
+            int32_t length;
+            ValuePeeker::peekObject_withoutNull(value, &length);
+            maxLength += sizeof (int32_t) + length;
+        }
+    }
+    return maxLength;
 }
 
 void ExportTupleStream::pushExportBuffer(StreamBlock *block, bool sync, bool endOfStream) {
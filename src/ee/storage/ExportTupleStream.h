@@ -22,10 +22,12 @@
 #include "common/FatalException.hpp"
 #include "storage/TupleStreamBase.h"
 #include <deque>
+#include <vector>
 #include <cassert>
 namespace voltdb {
 
 class StreamBlock;
+class ExportSerializeOutput;
 
 class ExportTupleStream : public voltdb::TupleStreamBase {
 public:
@@ -72,6 +74,20 @@ public:
                        TableTuple &tuple,
                        ExportTupleStream::Type type);
 
+    /**
+     * Write a batch of tuples from one transaction to the stream, with
+     * consecutive sequence numbers starting at seqNo. Returns the USO of
+     * the first tuple.
+     */
+    size_t appendTuples(int64_t lastCommittedSpHandle,
+                        int64_t spHandle,
+                        int64_t seqNo,
+                        int64_t uniqueId,
+                        int64_t timestamp,
+                        TableTuple *tuples,
+                        size_t tupleCount,
+                        ExportTupleStream::Type type);
+
     size_t computeOffsets(TableTuple &tuple,size_t *rowHeaderSz);
 
     virtual int partitionId() { return m_partitionId; }
@@ -82,6 +98,38 @@ public:
 
     std::string m_signature;
     int64_t m_generation;
+
+private:
+    /**
+     * One step of the serialization plan: either a run of adjacent
+     * fixed-width columns whose export encoding is byte-for-byte their tuple
+     * storage (copied at once when none of them is null), or a single column
+     * that goes through the generic NValue path.
+     */
+    struct ColumnStep {
+        bool fixedWidthRun;
+        int firstColumn;
+        int columnCount;
+        uint32_t storageOffset;
+        uint32_t length;
+    };
+
+    // Rebuild the serialization plan below for the schema of the appended tuples.
+    void compileSchema(const TupleSchema *schema);
+    size_t appendTupleToCurrentBlock(TableTuple &tuple, int64_t spHandle, int64_t seqNo,
+                                     int64_t timestamp, ExportTupleStream::Type type);
+    void serializeFixedWidthRun(const ColumnStep &run, const char *tupleData,
+                                ExportSerializeOutput &io, uint8_t *nullArray) const;
+
+    // The schema the plan was compiled for.
+    const TupleSchema *m_compiledSchema;
+    // 4 byte row length plus the null mask.
+    size_t m_rowHeaderSz;
+    // Upper bound on the bytes of everything except variable length columns.
+    size_t m_fixedMaxSz;
+    std::vector<ColumnStep> m_steps;
+    // Variable length columns, the only ones whose size depends on the tuple.
+    std::vector<int> m_varLengthColumns;
 };
 
 }
@@ -0,0 +1,225 @@
+/* This file is part of VoltDB.
+ * Copyright (C) 2008-2016 VoltDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with VoltDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "storage/MaterializedViewMinMaxTracker.h"
+
+#include "common/ValuePeeker.hpp"
+#include "storage/persistenttable.h"
+
+namespace voltdb {
+
+// Rough per-node costs of the containers, on top of the entries themselves.
+static const int64_t HASH_NODE_OVERHEAD = 2 * sizeof(void*);
+static const int64_t TREE_NODE_OVERHEAD = 4 * sizeof(void*);
+
+MaterializedViewMinMaxTracker::MaterializedViewMinMaxTracker(std::size_t trackedColumnCount,
+                                                             PersistentTable *target)
+    : m_trackedColumnCount(trackedColumnCount)
+    , m_memorySize(0)
+    , m_target(target)
+{ }
+
+MaterializedViewMinMaxTracker::~MaterializedViewMinMaxTracker()
+{
+    for (GroupMap::iterator group = m_groups.begin(); group != m_groups.end(); ++group) {
+        freeValues(group->first);
+        for (std::size_t ii = 0; ii < m_trackedColumnCount; ++ii) {
+            ValueCounts &counts = group->second[ii];
+            for (ValueCounts::iterator entry = counts.begin(); entry != counts.end(); ++entry) {
+                entry->first.free();
+            }
+        }
+    }
+    setTargetTable(NULL);
+}
+
+void MaterializedViewMinMaxTracker::setTargetTable(PersistentTable *target)
+{
+    if (target == m_target) {
+        return;
+    }
+    if (m_target) {
+        m_target->decreaseAuxiliaryMemCount(m_memorySize);
+    }
+    m_target = target;
+    if (m_target) {
+        m_target->increaseAuxiliaryMemCount(m_memorySize);
+    }
+}
+
+void MaterializedViewMinMaxTracker::adjustMemorySize(int64_t delta)
+{
+    m_memorySize += delta;
+    if (m_target == NULL) {
+        return;
+    }
+    if (delta > 0) {
+        m_target->increaseAuxiliaryMemCount(delta);
+    }
+    else {
+        m_target->decreaseAuxiliaryMemCount(-delta);
+    }
+}
+
+int64_t MaterializedViewMinMaxTracker::valueMemorySize(const NValue &value)
+{
+    int64_t size = sizeof(ValueCounts::value_type) + TREE_NODE_OVERHEAD;
+    if (isVariableLengthType(ValuePeeker::peekValueType(value))) {
+        size += value.getAllocationSizeForObject();
+    }
+    return size;
+}
+
+int64_t MaterializedViewMinMaxTracker::groupMemorySize(const std::vector<NValue> &groupKey) const
+{
+    int64_t size = sizeof(GroupMap::value_type) + HASH_NODE_OVERHEAD +
+        m_trackedColumnCount * sizeof(ValueCounts) + groupKey.size() * sizeof(NValue);
+    for (std::size_t ii = 0; ii < groupKey.size(); ++ii) {
+        if (isVariableLengthType(ValuePeeker::peekValueType(groupKey[ii]))) {
+            size += groupKey[ii].getAllocationSizeForObject();
+        }
+    }
+    return size;
+}
+
+void MaterializedViewMinMaxTracker::freeValues(const std::vector<NValue> &values)
+{
+    for (std::size_t ii = 0; ii < values.size(); ++ii) {
+        values[ii].free();
+    }
+}
+
+void MaterializedViewMinMaxTracker::addValues(const std::vector<NValue> &groupKey,
+                                              const std::vector<NValue> &values)
+{
+    assert(values.size() == m_trackedColumnCount);
+    GroupMap::iterator group = m_groups.find(groupKey);
+    if (group == m_groups.end()) {
+        std::vector<NValue> ownKey(groupKey.size());
+        for (std::size_t ii = 0; ii < groupKey.size(); ++ii) {
+            ownKey[ii] = groupKey[ii].copyNValueToPersistentStorage();
+        }
+        group = m_groups.insert(std::make_pair(ownKey,
+                                               std::vector<ValueCounts>(m_trackedColumnCount))).first;
+        adjustMemorySize(groupMemorySize(ownKey));
+    }
+    for (std::size_t ii = 0; ii < m_trackedColumnCount; ++ii) {
+        const NValue &value = values[ii];
+        if (value.isNull()) {
+            continue;
+        }
+        ValueCounts &counts = group->second[ii];
+        ValueCounts::iterator entry = counts.find(value);
+        if (entry != counts.end()) {
+            ++entry->second;
+            continue;
+        }
+        NValue ownValue = value.copyNValueToPersistentStorage();
+        counts.insert(std::make_pair(ownValue, 1));
+        adjustMemorySize(valueMemorySize(ownValue));
+    }
+}
+
+void MaterializedViewMinMaxTracker::removeValues(const std::vector<NValue> &groupKey,
+                                                 const std::vector<NValue> &values)
+{
+    assert(values.size() == m_trackedColumnCount);
+    GroupMap::iterator group = m_groups.find(groupKey);
+    if (group == m_groups.end()) {
+        return;
+    }
+    bool groupIsEmpty = true;
+    for (std::size_t ii = 0; ii < m_trackedColumnCount; ++ii) {
+        ValueCounts &counts = group->second[ii];
+        const NValue &value = values[ii];
+        if ( ! value.isNull()) {
+            ValueCounts::iterator entry = counts.find(value);
+            if (entry != counts.end() && --entry->second == 0) {
+                adjustMemorySize(-valueMemorySize(entry->first));
+                NValue ownValue = entry->first;
+                counts.erase(entry);
+                ownValue.free();
+            }
+        }
+        if ( ! counts.empty()) {
+            groupIsEmpty = false;
+        }
+    }
+    // Rows whose inputs are all NULL leave nothing to track, so the entry can go.
+    if (groupIsEmpty) {
+        adjustMemorySize(-groupMemorySize(group->first));
+        std::vector<NValue> ownKey = group->first;
+        m_groups.erase(group);
+        freeValues(ownKey);
+    }
+}
+
+bool MaterializedViewMinMaxTracker::findExtremeValue(const std::vector<NValue> &groupKey,
+                                                     int trackedIndex,
+                                                     bool forMin,
+                                                     NValue &valueOut) const
+{
+    GroupMap::const_iterator group = m_groups.find(groupKey);
+    if (group == m_groups.end()) {
+        return false;
+    }
+    const ValueCounts &counts = group->second[trackedIndex];
+    if (counts.empty()) {
+        return false;
+    }
+    valueOut = forMin ? counts.begin()->first : counts.rbegin()->first;
+    return true;
+}
+
+MaterializedViewMinMaxUndoAction::MaterializedViewMinMaxUndoAction(
+        boost::shared_ptr<MaterializedViewMinMaxTracker> tracker,
+        const std::vector<NValue> &groupKey,
+        const std::vector<NValue> &values,
+        bool undoAdd)
+    : m_tracker(tracker)
+    , m_groupKey(groupKey.size())
+    , m_values(values.size())
+    , m_undoAdd(undoAdd)
+{
+    for (std::size_t ii = 0; ii < groupKey.size(); ++ii) {
+        m_groupKey[ii] = groupKey[ii].copyNValueToPersistentStorage();
+    }
+    for (std::size_t ii = 0; ii < values.size(); ++ii) {
+        m_values[ii] = values[ii].copyNValueToPersistentStorage();
+    }
+}
+
+MaterializedViewMinMaxUndoAction::~MaterializedViewMinMaxUndoAction()
+{
+    for (std::size_t ii = 0; ii < m_groupKey.size(); ++ii) {
+        m_groupKey[ii].free();
+    }
+    for (std::size_t ii = 0; ii < m_values.size(); ++ii) {
+        m_values[ii].free();
+    }
+}
+
+void MaterializedViewMinMaxUndoAction::undo()
+{
+    if (m_undoAdd) {
+        m_tracker->removeValues(m_groupKey, m_values);
+    }
+    else {
+        m_tracker->addValues(m_groupKey, m_values);
+    }
+}
+
+} // namespace voltdb
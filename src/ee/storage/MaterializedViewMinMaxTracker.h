@@ -0,0 +1,144 @@
+/* This file is part of VoltDB.
+ * Copyright (C) 2008-2016 VoltDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with VoltDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MATERIALIZEDVIEWMINMAXTRACKER_H_
+#define MATERIALIZEDVIEWMINMAXTRACKER_H_
+
+#include "common/NValue.hpp"
+#include "common/UndoAction.h"
+
+#include "boost/shared_ptr.hpp"
+#include "boost/unordered_map.hpp"
+
+#include <map>
+#include <vector>
+
+namespace voltdb {
+
+class PersistentTable;
+
+/**
+ * For each group of a materialized view, a counted multiset of the source
+ * values of each MIN or MAX column that has no index to fall back on.
+ * When the source row holding the current MIN or MAX goes away, the next
+ * one is read off the multiset instead of being searched for in the
+ * source table. The memory it holds is charged to the view table.
+ */
+class MaterializedViewMinMaxTracker {
+public:
+    MaterializedViewMinMaxTracker(std::size_t trackedColumnCount, PersistentTable *target);
+    ~MaterializedViewMinMaxTracker();
+
+    /**
+     * Count one more source row for each non-null value in the group.
+     * values holds one entry per tracked column.
+     */
+    void addValues(const std::vector<NValue> &groupKey, const std::vector<NValue> &values);
+
+    /**
+     * Forget one source row for each non-null value in the group,
+     * dropping the group when nothing remains of it.
+     */
+    void removeValues(const std::vector<NValue> &groupKey, const std::vector<NValue> &values);
+
+    /**
+     * The smallest (or largest) value left for a tracked column of the group.
+     * Returns false if the group has no non-null values for the column.
+     */
+    bool findExtremeValue(const std::vector<NValue> &groupKey, int trackedIndex,
+                          bool forMin, NValue &valueOut) const;
+
+    /**
+     * Move the memory accounting to another view table, or to none.
+     */
+    void setTargetTable(PersistentTable *target);
+
+    std::size_t trackedColumnCount() const { return m_trackedColumnCount; }
+    std::size_t groupCount() const { return m_groups.size(); }
+    int64_t memorySize() const { return m_memorySize; }
+
+    // Hashing for view group keys, which are vectors of group-by values.
+    struct GroupKeyHasher : std::unary_function<std::vector<NValue>, std::size_t>
+    {
+        std::size_t operator()(const std::vector<NValue> &key) const
+        {
+            std::size_t seed = 0;
+            for (std::size_t ii = 0; ii < key.size(); ++ii) {
+                key[ii].hashCombine(seed);
+            }
+            return seed;
+        }
+    };
+
+    struct GroupKeyEqualityChecker
+    {
+        bool operator()(const std::vector<NValue> &lhs, const std::vector<NValue> &rhs) const
+        {
+            assert(lhs.size() == rhs.size());
+            for (std::size_t ii = 0; ii < lhs.size(); ++ii) {
+                if (lhs[ii].compare(rhs[ii]) != 0) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+private:
+    typedef std::map<NValue, int64_t, NValue::ltNValue> ValueCounts;
+
+    typedef boost::unordered_map<std::vector<NValue>, std::vector<ValueCounts>,
+                                 GroupKeyHasher, GroupKeyEqualityChecker> GroupMap;
+
+    void adjustMemorySize(int64_t delta);
+    int64_t groupMemorySize(const std::vector<NValue> &groupKey) const;
+    static int64_t valueMemorySize(const NValue &value);
+    static void freeValues(const std::vector<NValue> &values);
+
+    const std::size_t m_trackedColumnCount;
+    GroupMap m_groups;
+    int64_t m_memorySize;
+    PersistentTable *m_target;
+};
+
+/**
+ * Reverses the change one source row made to a MaterializedViewMinMaxTracker.
+ * It keeps its own copies of the group key and values, and shares ownership
+ * of the tracker in case the view is dropped before the transaction ends.
+ */
+class MaterializedViewMinMaxUndoAction : public UndoAction {
+public:
+    MaterializedViewMinMaxUndoAction(boost::shared_ptr<MaterializedViewMinMaxTracker> tracker,
+                                     const std::vector<NValue> &groupKey,
+                                     const std::vector<NValue> &values,
+                                     bool undoAdd);
+    ~MaterializedViewMinMaxUndoAction();
+
+    void undo();
+
+    void release() { }
+
+private:
+    boost::shared_ptr<MaterializedViewMinMaxTracker> m_tracker;
+    std::vector<NValue> m_groupKey;
+    std::vector<NValue> m_values;
+    const bool m_undoAdd;
+};
+
+} // namespace voltdb
+
+#endif // MATERIALIZEDVIEWMINMAXTRACKER_H_
@@ -87,6 +87,24 @@ NValue MaterializedViewTriggerForInsert::getAggInputFromSrcTuple(int aggIndex,
     return tuple.getNValue(srcColIdx);
 }
 
+bool MaterializedViewTriggerForInsert::dependsOnColumns(const std::vector<bool> &columns) const {
+    std::vector<int> sourceColumns(m_groupByColIndexes.begin(), m_groupByColIndexes.end());
+    sourceColumns.insert(sourceColumns.end(), m_aggColIndexes.begin(), m_aggColIndexes.end());
+    ExpressionUtil::extractTupleValuesColumnIdx(m_filterPredicate.get(), sourceColumns);
+    BOOST_FOREACH(AbstractExpression *expr, m_groupByExprs) {
+        ExpressionUtil::extractTupleValuesColumnIdx(expr, sourceColumns);
+    }
+    BOOST_FOREACH(AbstractExpression *expr, m_aggExprs) {
+        ExpressionUtil::extractTupleValuesColumnIdx(expr, sourceColumns);
+    }
+    BOOST_FOREACH(int columnIndex, sourceColumns) {
+        if (columns[columnIndex]) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void MaterializedViewTriggerForInsert::processTupleInsert(const TableTuple &newTuple,
                                                           bool fallible) {
     // don't change the view if this tuple doesn't match the predicate
@@ -349,6 +367,14 @@ void MaterializedViewTriggerForInsert::initializeTupleHavingNoGroupBy(bool falli
 }
 
 bool MaterializedViewTriggerForInsert::findExistingTuple(const TableTuple &tuple) {
+    // find the key for this tuple (which is the group by columns)
+    for (int colindex = 0; colindex < m_groupByColumnCount; colindex++) {
+        m_searchKeyValue[colindex] = getGroupByValueFromSrcTuple(colindex, tuple);
+    }
+    return findExistingGroup();
+}
+
+bool MaterializedViewTriggerForInsert::findExistingGroup() {
     // For the case where there is no grouping column, like SELECT COUNT(*) FROM T;
     // We directly return the only row in the view. See ENG-7872.
     if (m_groupByColumnCount == 0) {
@@ -358,11 +384,8 @@ bool MaterializedViewTriggerForInsert::findExistingTuple(const TableTuple &tuple
         return true;
     }
 
-    // find the key for this tuple (which is the group by columns)
     for (int colindex = 0; colindex < m_groupByColumnCount; colindex++) {
-        NValue value = getGroupByValueFromSrcTuple(colindex, tuple);
-        m_searchKeyValue[colindex] = value;
-        m_searchKeyTuple.setNValue(colindex, value);
+        m_searchKeyTuple.setNValue(colindex, m_searchKeyValue[colindex]);
     }
 
     IndexCursor indexCursor(m_index->getTupleSchema());
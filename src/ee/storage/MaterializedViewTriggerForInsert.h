@@ -56,7 +56,14 @@ public:
      * Called when the source table is inserting a tuple. This will update the materialized view
      * destination table to reflect this change.
      */
-    void processTupleInsert(const TableTuple &newTuple, bool fallible);
+    virtual void processTupleInsert(const TableTuple &newTuple, bool fallible);
+
+    /**
+     * Whether the view reads any of the flagged source table columns in its
+     * predicate, its group by keys or its aggregates. An update that changes
+     * none of them leaves the view as it is.
+     */
+    bool dependsOnColumns(const std::vector<bool> &columns) const;
 
     PersistentTable * targetTable() const { return m_target; }
 
@@ -127,6 +134,11 @@ protected:
      */
     bool findExistingTuple(const TableTuple &oldTuple);
 
+    /**
+     * Same as findExistingTuple, for a group key already in m_searchKeyValue.
+     */
+    bool findExistingGroup();
+
     // the materialized view table
     PersistentTable *m_target;
 
@@ -21,6 +21,9 @@
 #include "catalog/indexref.h"
 #include "catalog/planfragment.h"
 #include "catalog/statement.h"
+#include "common/UndoQuantum.h"
+#include "common/ValuePeeker.hpp"
+#include "common/executorcontext.hpp"
 #include "execution/ExecutorVector.h"
 #include "executors/abstractexecutor.h"
 #include "indexes/tableindex.h"
@@ -38,9 +41,13 @@ MaterializedViewTriggerForWrite::MaterializedViewTriggerForWrite(PersistentTable
     : MaterializedViewTriggerForInsert(destTable, mvInfo)
     , m_srcPersistentTable(srcTable)
     , m_minMaxSearchKeyBackingStoreSize(0)
+    , m_deferringUpdates(false)
+    , m_deferredFallible(false)
+    , m_deltaGroupKey(m_groupByColumnCount)
 {
     // set up mechanisms for min/max recalculation
     setupMinMaxRecalculation(mvInfo->indexForMinMax(), mvInfo->fallbackQueryStmts());
+    bool trackerNeedsPopulating = setupMinMaxTracking();
 
     // Catch up on pre-existing source tuples UNLESS target tuples have already been migrated in.
     if (m_target->isPersistentTableEmpty()) {
@@ -65,6 +72,9 @@ MaterializedViewTriggerForWrite::MaterializedViewTriggerForWrite(PersistentTable
             }
         }
     }
+    else if (trackerNeedsPopulating) {
+        populateMinMaxTracker();
+    }
 }
 
 void MaterializedViewTriggerForWrite::build(PersistentTable *srcTable,
@@ -77,7 +87,23 @@ void MaterializedViewTriggerForWrite::build(PersistentTable *srcTable,
     VOLT_TRACE("finished initialization.");
 }
 
-MaterializedViewTriggerForWrite::~MaterializedViewTriggerForWrite() { }
+MaterializedViewTriggerForWrite::~MaterializedViewTriggerForWrite() {
+    freeGroupDeltas();
+    // Pending undo actions may outlive this view and its target table.
+    if (m_minMaxTracker) {
+        m_minMaxTracker->setTargetTable(NULL);
+    }
+}
+
+void MaterializedViewTriggerForWrite::updateDefinition(PersistentTable *destTable,
+                                                       catalog::MaterializedViewInfo *mvInfo) {
+    MaterializedViewTriggerForInsert::updateDefinition(destTable, mvInfo);
+    setupMinMaxRecalculation(mvInfo->indexForMinMax(),
+                             mvInfo->fallbackQueryStmts());
+    if (setupMinMaxTracking()) {
+        populateMinMaxTracker();
+    }
+}
 
 void MaterializedViewTriggerForWrite::setupMinMaxRecalculation(const catalog::CatalogMap<catalog::IndexRef> &indexForMinOrMax,
                                                                const catalog::CatalogMap<catalog::Statement> &fallbackQueryStmts) {
@@ -167,6 +193,81 @@ static bool minMaxIndexIncludesAggCol(TableIndex * index, size_t groupByColumnCo
     return index && index->getColumnIndices().size() > groupByColumnCount;
 }
 
+bool MaterializedViewTriggerForWrite::setupMinMaxTracking() {
+    // Only columns whose fallback would scan the group or the table need value sets.
+    std::vector<int> trackedSlot;
+    std::vector<int> trackedAggIndexes;
+    for (int aggIndex = 0; aggIndex < m_aggColumnCount; aggIndex++) {
+        if (m_aggTypes[aggIndex] != EXPRESSION_TYPE_AGGREGATE_MIN &&
+            m_aggTypes[aggIndex] != EXPRESSION_TYPE_AGGREGATE_MAX) {
+            continue;
+        }
+        size_t minMaxAggIdx = trackedSlot.size();
+        TableIndex *index = minMaxAggIdx < m_indexForMinMax.size() ? m_indexForMinMax[minMaxAggIdx] : NULL;
+        if (minMaxIndexIncludesAggCol(index, m_groupByColumnCount)) {
+            trackedSlot.push_back(-1);
+        }
+        else {
+            trackedSlot.push_back((int)trackedAggIndexes.size());
+            trackedAggIndexes.push_back(aggIndex);
+        }
+    }
+    m_minMaxTrackedSlot = trackedSlot;
+
+    if (m_minMaxTracker && trackedAggIndexes == m_trackedAggIndexes) {
+        m_minMaxTracker->setTargetTable(m_target);
+        return false;
+    }
+    m_trackedAggIndexes = trackedAggIndexes;
+    if (m_minMaxTracker) {
+        m_minMaxTracker->setTargetTable(NULL);
+        m_minMaxTracker.reset();
+    }
+    if (m_trackedAggIndexes.empty()) {
+        return false;
+    }
+    m_minMaxTracker.reset(new MaterializedViewMinMaxTracker(m_trackedAggIndexes.size(), m_target));
+    m_minMaxGroupKey.resize(m_groupByColumnCount);
+    m_minMaxTrackedValues.resize(m_trackedAggIndexes.size());
+    return true;
+}
+
+void MaterializedViewTriggerForWrite::populateMinMaxTracker() {
+    TableTuple scannedTuple(m_srcPersistentTable->schema());
+    TableIterator &iterator = m_srcPersistentTable->iterator();
+    while (iterator.next(scannedTuple)) {
+        if ( ! failsPredicate(scannedTuple)) {
+            trackMinMaxValues(scannedTuple, true, false);
+        }
+    }
+}
+
+void MaterializedViewTriggerForWrite::trackMinMaxValues(const TableTuple &tuple,
+                                                        bool isInsert,
+                                                        bool fallible) {
+    for (int colindex = 0; colindex < m_groupByColumnCount; colindex++) {
+        m_minMaxGroupKey[colindex] = getGroupByValueFromSrcTuple(colindex, tuple);
+    }
+    for (size_t slot = 0; slot < m_trackedAggIndexes.size(); slot++) {
+        m_minMaxTrackedValues[slot] = getAggInputFromSrcTuple(m_trackedAggIndexes[slot], tuple);
+    }
+    if (isInsert) {
+        m_minMaxTracker->addValues(m_minMaxGroupKey, m_minMaxTrackedValues);
+    }
+    else {
+        m_minMaxTracker->removeValues(m_minMaxGroupKey, m_minMaxTrackedValues);
+    }
+    if (fallible) {
+        UndoQuantum *uq = ExecutorContext::currentUndoQuantum();
+        if (uq) {
+            uq->registerUndoAction(new (*uq) MaterializedViewMinMaxUndoAction(m_minMaxTracker,
+                                                                              m_minMaxGroupKey,
+                                                                              m_minMaxTrackedValues,
+                                                                              isInsert));
+        }
+    }
+}
+
 void MaterializedViewTriggerForWrite::allocateMinMaxSearchKeyTuple() {
     uint32_t nextIndexStoreLength;
     size_t minMaxSearchKeyBackingStoreSize = 0;
@@ -383,6 +484,20 @@ NValue MaterializedViewTriggerForWrite::findFallbackValueUsingPlan(const TableTu
     return newVal;
 }
 
+void MaterializedViewTriggerForWrite::processTupleInsert(const TableTuple &newTuple,
+                                                         bool fallible) {
+    if (m_deferringUpdates) {
+        if ( ! failsPredicate(newTuple)) {
+            deferTupleInsert(newTuple, fallible);
+        }
+        return;
+    }
+    MaterializedViewTriggerForInsert::processTupleInsert(newTuple, fallible);
+    if (m_minMaxTracker && ! failsPredicate(newTuple)) {
+        trackMinMaxValues(newTuple, true, fallible);
+    }
+}
+
 void MaterializedViewTriggerForWrite::processTupleDelete(const TableTuple &oldTuple,
         bool fallible) {
     // don't change the view if this tuple doesn't match the predicate
@@ -390,6 +505,15 @@ void MaterializedViewTriggerForWrite::processTupleDelete(const TableTuple &oldTu
         return;
     }
 
+    if (m_deferringUpdates) {
+        if (canDeferDeletes()) {
+            deferTupleDelete(oldTuple, fallible);
+            return;
+        }
+        // The view rows must be up to date before one is changed directly.
+        applyGroupDeltas();
+    }
+
     if ( ! findExistingTuple(oldTuple)) {
         std::string name = m_target->name();
         throwFatalException("MaterializedViewTriggerForWrite for table %s went"
@@ -397,6 +521,12 @@ void MaterializedViewTriggerForWrite::processTupleDelete(const TableTuple &oldTu
                             " expected to find it but didn't", name.c_str());
     }
 
+    // The tracked value sets no longer count this row, so they hold the
+    // fallback MIN/MAX values directly.
+    if (m_minMaxTracker) {
+        trackMinMaxValues(oldTuple, false, fallible);
+    }
+
     // clear the tuple that will be built to insert or overwrite
     memset(m_updatedTuple.address(), 0, m_target->getTupleLength());
 
@@ -459,7 +589,12 @@ void MaterializedViewTriggerForWrite::processTupleDelete(const TableTuple &oldTu
                 if (oldValue.compare(existingValue) == 0) {
                     // re-calculate MIN / MAX
                     newValue = NValue::getNullValue(m_target->schema()->columnType(aggOffset+aggIndex));
-                    if (m_usePlanForAgg[minMaxAggIdx] && allowUsingPlanForMinMax) {
+                    int trackedSlot = m_minMaxTrackedSlot[minMaxAggIdx];
+                    if (trackedSlot >= 0) {
+                        m_minMaxTracker->findExtremeValue(m_minMaxGroupKey, trackedSlot,
+                                                          reversedForMin == -1, newValue);
+                    }
+                    else if (m_usePlanForAgg[minMaxAggIdx] && allowUsingPlanForMinMax) {
                         newValue = findFallbackValueUsingPlan(oldTuple, newValue, aggIndex, minMaxAggIdx);
                     }
                     // indexscan if an index is available, otherwise tablescan
@@ -495,4 +630,238 @@ void MaterializedViewTriggerForWrite::processTupleDelete(const TableTuple &oldTu
                                              m_updatableIndexList, fallible);
 }
 
+MaterializedViewTriggerForWrite::GroupDelta &
+MaterializedViewTriggerForWrite::findGroupDelta(const TableTuple &tuple) {
+    for (int colindex = 0; colindex < m_groupByColumnCount; colindex++) {
+        m_deltaGroupKey[colindex] = getGroupByValueFromSrcTuple(colindex, tuple);
+    }
+    GroupDeltaMap::iterator found = m_groupDeltas.find(m_deltaGroupKey);
+    if (found != m_groupDeltas.end()) {
+        return found->second;
+    }
+
+    // The key may point into a source row that changes before the deltas are applied.
+    std::vector<NValue> groupKey(m_groupByColumnCount);
+    for (int colindex = 0; colindex < m_groupByColumnCount; colindex++) {
+        groupKey[colindex] = m_deltaGroupKey[colindex].copyNValueToPersistentStorage();
+    }
+    GroupDelta delta;
+    delta.m_countDelta = 0;
+    delta.m_hasDeletes = false;
+    delta.m_aggDeltas.resize(m_aggColumnCount);
+    int aggOffset = (int)m_groupByColumnCount + 1;
+    for (int aggIndex = 0; aggIndex < m_aggColumnCount; aggIndex++) {
+        if (m_aggTypes[aggIndex] == EXPRESSION_TYPE_AGGREGATE_COUNT) {
+            delta.m_aggDeltas[aggIndex] = ValueFactory::getBigIntValue(0);
+        }
+        else {
+            delta.m_aggDeltas[aggIndex] =
+                NValue::getNullValue(m_target->schema()->columnType(aggOffset+aggIndex));
+        }
+    }
+    return m_groupDeltas.insert(std::make_pair(groupKey, delta)).first->second;
+}
+
+void MaterializedViewTriggerForWrite::deferTupleInsert(const TableTuple &newTuple,
+                                                       bool fallible) {
+    if (m_minMaxTracker) {
+        trackMinMaxValues(newTuple, true, fallible);
+    }
+    GroupDelta &delta = findGroupDelta(newTuple);
+    m_deferredFallible = m_deferredFallible || fallible;
+    ++delta.m_countDelta;
+    for (int aggIndex = 0; aggIndex < m_aggColumnCount; aggIndex++) {
+        NValue newValue = getAggInputFromSrcTuple(aggIndex, newTuple);
+        if (newValue.isNull()) {
+            continue;
+        }
+        NValue &aggDelta = delta.m_aggDeltas[aggIndex];
+        int reversedForMin = 1; // initially assume that agg is not MIN.
+        switch(m_aggTypes[aggIndex]) {
+        case EXPRESSION_TYPE_AGGREGATE_SUM:
+            aggDelta = aggDelta.isNull() ? newValue : aggDelta.op_add(newValue);
+            break;
+        case EXPRESSION_TYPE_AGGREGATE_COUNT:
+            aggDelta = aggDelta.op_increment();
+            break;
+        case EXPRESSION_TYPE_AGGREGATE_MIN:
+            reversedForMin = -1; // fall through...
+            // no break
+        case EXPRESSION_TYPE_AGGREGATE_MAX:
+            // keep only the best of the inserted values
+            if (aggDelta.isNull() || (reversedForMin * newValue.compare(aggDelta)) > 0) {
+                aggDelta.free();
+                aggDelta = newValue.copyNValueToPersistentStorage();
+            }
+            break;
+        default:
+            assert(false); // Should have been caught when the matview was loaded.
+            // no break
+        }
+    }
+}
+
+void MaterializedViewTriggerForWrite::deferTupleDelete(const TableTuple &oldTuple,
+                                                       bool fallible) {
+    if (m_minMaxTracker) {
+        trackMinMaxValues(oldTuple, false, fallible);
+    }
+    GroupDelta &delta = findGroupDelta(oldTuple);
+    m_deferredFallible = m_deferredFallible || fallible;
+    --delta.m_countDelta;
+    delta.m_hasDeletes = true;
+    for (int aggIndex = 0; aggIndex < m_aggColumnCount; aggIndex++) {
+        NValue oldValue = getAggInputFromSrcTuple(aggIndex, oldTuple);
+        if (oldValue.isNull()) {
+            continue;
+        }
+        NValue &aggDelta = delta.m_aggDeltas[aggIndex];
+        switch(m_aggTypes[aggIndex]) {
+        case EXPRESSION_TYPE_AGGREGATE_SUM:
+            aggDelta = aggDelta.isNull() ? ValueFactory::getBigIntValue(0).op_subtract(oldValue) :
+                                           aggDelta.op_subtract(oldValue);
+            break;
+        case EXPRESSION_TYPE_AGGREGATE_COUNT:
+            aggDelta = aggDelta.op_decrement();
+            break;
+        case EXPRESSION_TYPE_AGGREGATE_MIN:
+        case EXPRESSION_TYPE_AGGREGATE_MAX:
+            // the value sets already reflect the delete
+            break;
+        default:
+            assert(false); // Should have been caught when the matview was loaded.
+            // no break
+        }
+    }
+}
+
+void MaterializedViewTriggerForWrite::applyDeferredUpdates() {
+    m_deferringUpdates = false;
+    applyGroupDeltas();
+}
+
+void MaterializedViewTriggerForWrite::discardDeferredUpdates() {
+    m_deferringUpdates = false;
+    freeGroupDeltas();
+}
+
+void MaterializedViewTriggerForWrite::applyGroupDeltas() {
+    try {
+        for (GroupDeltaMap::const_iterator group = m_groupDeltas.begin();
+             group != m_groupDeltas.end(); ++group) {
+            applyGroupDelta(group->first, group->second);
+        }
+    }
+    catch (...) {
+        freeGroupDeltas();
+        throw;
+    }
+    freeGroupDeltas();
+}
+
+void MaterializedViewTriggerForWrite::applyGroupDelta(const std::vector<NValue> &groupKey,
+                                                      const GroupDelta &delta) {
+    for (int colindex = 0; colindex < m_groupByColumnCount; colindex++) {
+        m_searchKeyValue[colindex] = groupKey[colindex];
+    }
+    bool exists = findExistingGroup();
+    int64_t count = delta.m_countDelta;
+    if (exists) {
+        count += ValuePeeker::peekBigInt(m_existingTuple.getNValue((int)m_groupByColumnCount));
+    }
+    else if (count == 0) {
+        // Every row this statement added to the group, it also took away.
+        return;
+    }
+    if (count < 0) {
+        std::string name = m_target->name();
+        throwFatalException("MaterializedViewTriggerForWrite for table %s went"
+                            " looking for a tuple in the view and"
+                            " expected to find it but didn't", name.c_str());
+    }
+
+    if (count == 0) {
+        m_target->deleteTuple(m_existingTuple, m_deferredFallible);
+        // If there is no group by column, the count() should remain 0 and other functions should
+        // have value null. See ENG-7872.
+        if (m_groupByColumnCount == 0) {
+            initializeTupleHavingNoGroupBy(m_deferredFallible);
+        }
+        return;
+    }
+
+    // clear the tuple that will be built to insert or overwrite
+    memset(m_updatedTuple.address(), 0, m_target->getTupleLength());
+    for (int colindex = 0; colindex < m_groupByColumnCount; colindex++) {
+        // As in processTupleInsert, prefer the values already in the view.
+        NValue value = exists ? m_existingTuple.getNValue(colindex) : groupKey[colindex];
+        m_updatedTuple.setNValue(colindex, value);
+    }
+    m_updatedTuple.setNValue((int)m_groupByColumnCount, ValueFactory::getBigIntValue(count));
+
+    int aggOffset = (int)m_groupByColumnCount + 1;
+    int minMaxAggIdx = 0;
+    for (int aggIndex = 0; aggIndex < m_aggColumnCount; aggIndex++) {
+        const NValue &aggDelta = delta.m_aggDeltas[aggIndex];
+        NValue existingValue = exists ?
+            m_existingTuple.getNValue(aggOffset+aggIndex) :
+            NValue::getNullValue(m_target->schema()->columnType(aggOffset+aggIndex));
+        NValue newValue = existingValue;
+        int reversedForMin = 1; // initially assume that agg is not MIN.
+        switch(m_aggTypes[aggIndex]) {
+        case EXPRESSION_TYPE_AGGREGATE_SUM:
+            if ( ! aggDelta.isNull()) {
+                newValue = existingValue.isNull() ? aggDelta : existingValue.op_add(aggDelta);
+            }
+            break;
+        case EXPRESSION_TYPE_AGGREGATE_COUNT:
+            newValue = exists ? existingValue.op_add(aggDelta) : aggDelta;
+            break;
+        case EXPRESSION_TYPE_AGGREGATE_MIN:
+            reversedForMin = -1; // fall through...
+            // no break
+        case EXPRESSION_TYPE_AGGREGATE_MAX:
+            if (delta.m_hasDeletes) {
+                // Deletes are only deferred when every MIN/MAX column has a value set.
+                newValue = NValue::getNullValue(m_target->schema()->columnType(aggOffset+aggIndex));
+                m_minMaxTracker->findExtremeValue(groupKey, m_minMaxTrackedSlot[minMaxAggIdx],
+                                                  reversedForMin == -1, newValue);
+            }
+            else if ( ! aggDelta.isNull() &&
+                      (existingValue.isNull() || (reversedForMin * aggDelta.compare(existingValue)) > 0)) {
+                newValue = aggDelta;
+            }
+            minMaxAggIdx++;
+            break;
+        default:
+            assert(false); // Should have been caught when the matview was loaded.
+            // no break
+        }
+        m_updatedTuple.setNValue(aggOffset+aggIndex, newValue);
+    }
+
+    if (exists) {
+        m_target->updateTupleWithSpecificIndexes(m_existingTuple, m_updatedTuple,
+                                                 m_updatableIndexList, m_deferredFallible);
+    }
+    else {
+        m_target->insertPersistentTuple(m_updatedTuple, m_deferredFallible);
+    }
+}
+
+void MaterializedViewTriggerForWrite::freeGroupDeltas() {
+    for (GroupDeltaMap::iterator group = m_groupDeltas.begin();
+         group != m_groupDeltas.end(); ++group) {
+        for (size_t ii = 0; ii < group->first.size(); ++ii) {
+            group->first[ii].free();
+        }
+        // Only MIN and MAX deltas can hold strings; freeing the others does nothing.
+        for (size_t ii = 0; ii < group->second.m_aggDeltas.size(); ++ii) {
+            group->second.m_aggDeltas[ii].free();
+        }
+    }
+    m_groupDeltas.clear();
+    m_deferredFallible = false;
+}
+
 } // namespace voltdb
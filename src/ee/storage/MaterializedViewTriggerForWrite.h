@@ -19,6 +19,7 @@
 #define MATERIALIZEDVIEWTRIGGERFORWRITE_H_
 
 #include "MaterializedViewTriggerForInsert.h"
+#include "MaterializedViewMinMaxTracker.h"
 
 namespace voltdb {
 
@@ -36,6 +37,12 @@ public:
                       catalog::MaterializedViewInfo *mvInfo);
     ~MaterializedViewTriggerForWrite();
 
+    /**
+     * Extends the base class insert handling to also count the new row's
+     * values in the MIN/MAX value sets.
+     */
+    void processTupleInsert(const TableTuple &newTuple, bool fallible);
+
     /**
      * This updates the materialized view desitnation table to reflect
      * write operations to the source table.
@@ -46,11 +53,26 @@ public:
     void processTupleDelete(const TableTuple &oldTuple, bool fallible);
 
     void updateDefinition(PersistentTable *destTable,
-                          catalog::MaterializedViewInfo *mvInfo) {
-        MaterializedViewTriggerForInsert::updateDefinition(destTable, mvInfo);
-        setupMinMaxRecalculation(mvInfo->indexForMinMax(),
-                                 mvInfo->fallbackQueryStmts());
-    }
+                          catalog::MaterializedViewInfo *mvInfo);
+
+    /**
+     * Until applyDeferredUpdates is called, sum up the changes from source rows
+     * per view group instead of rewriting the group's view row for each one.
+     * Used for multi-row DML statements.
+     */
+    void deferUpdates() { m_deferringUpdates = true; }
+
+    /**
+     * Write the summed up changes to the view, once per group, and go back
+     * to maintaining the view row by row.
+     */
+    void applyDeferredUpdates();
+
+    /**
+     * Drop the summed up changes without writing them, for when the
+     * statement is failing anyway and applying them failed too.
+     */
+    void discardDeferredUpdates();
 
 
 private:
@@ -63,6 +85,42 @@ private:
 
     void allocateMinMaxSearchKeyTuple();
 
+    /**
+     * Decide which MIN/MAX columns to keep value sets for. Returns true
+     * if a new, empty tracker was set up that needs to be populated.
+     */
+    bool setupMinMaxTracking();
+
+    void populateMinMaxTracker();
+
+    void trackMinMaxValues(const TableTuple &tuple, bool isInsert, bool fallible);
+
+    // The net change to one view group from the source rows of a statement.
+    struct GroupDelta {
+        int64_t m_countDelta;
+        // The SUM and COUNT changes, and the best inserted MIN or MAX values.
+        std::vector<NValue> m_aggDeltas;
+        // Removed MIN or MAX values are taken care of by m_minMaxTracker.
+        bool m_hasDeletes;
+    };
+
+    typedef boost::unordered_map<std::vector<NValue>, GroupDelta,
+                                 MaterializedViewMinMaxTracker::GroupKeyHasher,
+                                 MaterializedViewMinMaxTracker::GroupKeyEqualityChecker> GroupDeltaMap;
+
+    // Deletes can only be summed up if no MIN or MAX column needs a search
+    // of the source table to find its next value.
+    bool canDeferDeletes() const {
+        return m_trackedAggIndexes.size() == m_minMaxTrackedSlot.size();
+    }
+
+    GroupDelta &findGroupDelta(const TableTuple &tuple);
+    void deferTupleInsert(const TableTuple &newTuple, bool fallible);
+    void deferTupleDelete(const TableTuple &oldTuple, bool fallible);
+    void applyGroupDeltas();
+    void applyGroupDelta(const std::vector<NValue> &groupKey, const GroupDelta &delta);
+    void freeGroupDeltas();
+
     NValue findMinMaxFallbackValueIndexed(const TableTuple& oldTuple,
                                           const NValue &existingValue,
                                           const NValue &initialNull,
@@ -91,6 +149,20 @@ private:
     // Executor vectors to be executed when fallback on min/max value is needed (ENG-8641).
     std::vector<boost::shared_ptr<ExecutorVector> > m_fallbackExecutorVectors;
     std::vector<bool> m_usePlanForAgg;
+    // For each MIN/MAX column, its slot in m_minMaxTracker, or -1 if it has
+    // an index that covers the aggregated value and so needs no value set.
+    std::vector<int> m_minMaxTrackedSlot;
+    // The aggregate index of the column tracked in each slot.
+    std::vector<int> m_trackedAggIndexes;
+    boost::shared_ptr<MaterializedViewMinMaxTracker> m_minMaxTracker;
+    // Scratch space for the group key and tracked values of a source row.
+    std::vector<NValue> m_minMaxGroupKey;
+    std::vector<NValue> m_minMaxTrackedValues;
+    bool m_deferringUpdates;
+    bool m_deferredFallible;
+    GroupDeltaMap m_groupDeltas;
+    // Scratch space for the group key of a source row.
+    std::vector<NValue> m_deltaGroupKey;
 
 };
 
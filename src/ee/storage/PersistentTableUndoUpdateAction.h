@@ -28,10 +28,15 @@ namespace voltdb {
 class PersistentTableUndoUpdateAction: public UndoAction {
 public:
 
-    inline PersistentTableUndoUpdateAction(char* oldTuple, char* newTuple,
+    /*
+     * newTuple is a pooled copy of the updated tuple, used to find it again.
+     * oldValues holds only the bytes of the tuple that the update changed,
+     * as they were before it (see PersistentTable::updateTupleForUndo).
+     */
+    inline PersistentTableUndoUpdateAction(char* newTuple, const char* oldValues,
                                            std::vector<char*> const & oldObjects, std::vector<char*> const & newObjects,
                                            PersistentTableSurgeon *table, bool revertIndexes)
-      : m_oldTuple(oldTuple), m_newTuple(newTuple),
+      : m_newTuple(newTuple), m_oldValues(oldValues),
         m_table(table), m_revertIndexes(revertIndexes),
         m_oldUninlineableColumns(oldObjects), m_newUninlineableColumns(newObjects)
     { }
@@ -39,11 +44,11 @@ public:
     /*
      * Undo whatever this undo action was created to undo. In this
      * case the string allocations of the new tuple must be freed and
-     * the tuple must be overwritten with the old one.
+     * the changed bytes of the tuple must be put back.
      */
     virtual void undo()
     {
-        m_table->updateTupleForUndo(m_newTuple, m_oldTuple, m_revertIndexes);
+        m_table->updateTupleForUndo(m_newTuple, m_oldValues, m_revertIndexes);
         NValue::freeObjectsFromTupleStorage(m_newUninlineableColumns);
     }
 
@@ -57,8 +62,8 @@ public:
     virtual ~PersistentTableUndoUpdateAction() { }
 
 private:
-    char* const m_oldTuple;
     char* const m_newTuple;
+    const char* const m_oldValues;
     PersistentTableSurgeon * const m_table;
     bool const m_revertIndexes;
     std::vector<char*> const m_oldUninlineableColumns;
@@ -769,6 +769,34 @@ TableCatalogDelegate::processSchemaChanges(catalog::Database const &catalogDatab
     }
 }
 
+bool TableCatalogDelegate::relaxSchemaInPlace(catalog::Database const &catalogDatabase,
+                                              catalog::Table const &catalogTable)
+{
+    PersistentTable* persistentTable = dynamic_cast<PersistentTable*>(m_table);
+    if ( ! persistentTable || catalogTable.isDRed() != persistentTable->isDREnabled()) {
+        return false;
+    }
+    // View handlers keep their own copy of the view table's schema.
+    if (catalogTable.materializer()) {
+        return false;
+    }
+    // Column names are kept by the table, not the schema.
+    map<string, catalog::Column*>::const_iterator col_iterator;
+    for (col_iterator = catalogTable.columns().begin();
+         col_iterator != catalogTable.columns().end(); col_iterator++) {
+        const catalog::Column *catalog_column = col_iterator->second;
+        if (catalog_column->index() >= persistentTable->columnCount() ||
+            persistentTable->columnName(catalog_column->index()) != catalog_column->name()) {
+            return false;
+        }
+    }
+
+    TupleSchema *schema = createTupleSchema(catalogDatabase, catalogTable);
+    bool relaxed = persistentTable->relaxSchemaInPlace(schema);
+    TupleSchema::freeTupleSchema(schema);
+    return relaxed;
+}
+
 void TableCatalogDelegate::deleteCommand()
 {
     if (m_table) {
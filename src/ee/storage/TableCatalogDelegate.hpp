@@ -75,6 +75,14 @@ class TableCatalogDelegate {
                              catalog::Table const &catalogTable,
                              std::map<std::string, TableCatalogDelegate*> const &tablesByName);
 
+    /**
+     * Apply a schema change that keeps the tuple format to the existing
+     * table instead of rebuilding it. Returns false if the change needs
+     * processSchemaChanges.
+     */
+    bool relaxSchemaInPlace(catalog::Database const &catalogDatabase,
+                            catalog::Table const &catalogTable);
+
     static TupleSchema *createTupleSchema(catalog::Database const &catalogDatabase,
                                           catalog::Table const &catalogTable);
 
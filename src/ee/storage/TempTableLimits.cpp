@@ -47,6 +47,9 @@ void TempTableLimits::increaseAllocated(int bytes)
     if (m_currMemoryInBytes > m_peakMemoryInBytes) {
         m_peakMemoryInBytes = m_currMemoryInBytes;
     }
+    if (m_currMemoryInBytes > m_markedPeakMemoryInBytes) {
+        m_markedPeakMemoryInBytes = m_currMemoryInBytes;
+    }
 
     if ( m_logLatch || m_logThreshold <= 0 || m_currMemoryInBytes <= m_logThreshold) {
         return;
@@ -31,6 +31,7 @@ public:
     TempTableLimits(int64_t memoryLimit = 1024 * 1024 * 100, int64_t logThreshold = -1)
         : m_currMemoryInBytes(0)
         , m_peakMemoryInBytes(0)
+        , m_markedPeakMemoryInBytes(0)
         , m_logThreshold(logThreshold)
         , m_memoryLimit(memoryLimit)
         , m_logLatch(false)
@@ -46,14 +47,34 @@ public:
 
     int64_t getAllocated() const { return m_currMemoryInBytes; }
     int64_t getPeakMemoryInBytes() const { return m_peakMemoryInBytes; }
+    int64_t getMemoryLimit() const { return m_memoryLimit; }
     void resetPeakMemory() { m_peakMemoryInBytes = m_currMemoryInBytes; }
 
+    /**
+     * Start tracking a separate high water mark from the current allocation,
+     * returning the one tracked so far so that it can be handed back to
+     * restorePeakMemoryMark when marks are nested.
+     */
+    int64_t markPeakMemory() {
+        int64_t previous = m_markedPeakMemoryInBytes;
+        m_markedPeakMemoryInBytes = m_currMemoryInBytes;
+        return previous;
+    }
+    int64_t getPeakMemorySinceMark() const { return m_markedPeakMemoryInBytes; }
+    void restorePeakMemoryMark(int64_t previous) {
+        if (previous > m_markedPeakMemoryInBytes) {
+            m_markedPeakMemoryInBytes = previous;
+        }
+    }
+
 private:
     /// The current amount of memory used by temp tables for this plan fragment.
     int64_t m_currMemoryInBytes;
     /// The high water amount of memory used by temp tables
     /// during the current execution of this plan fragment.
     int64_t m_peakMemoryInBytes;
+    /// The high water amount of memory used since the last markPeakMemory.
+    int64_t m_markedPeakMemoryInBytes;
     /// The memory allocation at which a log message will be generated.
     /// A negative value disables this behavior.
     const int64_t m_logThreshold;
@@ -18,6 +18,7 @@
 #include "storage/table.h"
 #include <sys/mman.h>
 #include <errno.h>
+#include "common/MemoryPolicy.h"
 #include "common/ThreadLocalPool.h"
 
 namespace voltdb {
@@ -33,7 +34,8 @@ TupleBlock::TupleBlock(Table *table, TBBucketPtr bucket) :
         m_nextFreeTuple(0),
         m_lastCompactionOffset(0),
         m_bucket(bucket),
-        m_bucketIndex(0)
+        m_bucketIndex(0),
+        m_mappedStorage(bucket.get() != NULL)
 {
 #ifdef USE_MMAP
     size_t tableAllocationSize = static_cast<size_t> (m_tupleLength * m_tuplesPerBlock);
@@ -43,7 +45,16 @@ TupleBlock::TupleBlock(Table *table, TBBucketPtr bucket) :
         throwFatalException("Failed mmap");
     }
 #else
-    m_storage = new char[table->m_tableAllocationSize];
+    // Blocks of persistent tables, which come with a compaction bucket,
+    // are long lived and mapped as the memory policy says. Temp table
+    // blocks come and go with each fragment, and stay on the heap where
+    // they are reused without faulting in fresh pages.
+    if (m_mappedStorage) {
+        m_storage = static_cast<char*>(MemoryPolicy::allocateBlock(m_tupleLength * m_tuplesPerBlock));
+    }
+    else {
+        m_storage = new char[table->m_tableAllocationSize];
+    }
 #endif
     tupleBlocksAllocated++;
 }
@@ -56,7 +67,12 @@ TupleBlock::~TupleBlock() {
         throwFatalException("Failed munmap");
     }
 #else
-    delete []m_storage;
+    if (m_mappedStorage) {
+        MemoryPolicy::freeBlock(m_storage, m_tupleLength * m_tuplesPerBlock);
+    }
+    else {
+        delete []m_storage;
+    }
 #endif
 }
 
@@ -70,6 +86,9 @@ std::pair<int, int> TupleBlock::merge(Table *table, TBPtr source, TupleMovementL
                 << " and active tuple count is " << source->m_activeTuples << std::endl;
     */
 
+    // The tuples moved in keep the zone maps of this block covering them.
+    // Freeing the last tuple of the source resets its zones, so widen first.
+    widenZones(*source);
     uint32_t m_nextTupleInSourceOffset = source->lastCompactionOffset();
     int sourceTuplesPendingDeleteOnUndoRelease = 0;
     while (hasFreeTuples() && !source->isEmpty()) {
@@ -29,6 +29,7 @@
 #include "stx/btree_set.h"
 #include <math.h>
 #include <iostream>
+#include <limits>
 #include "boost_ext/FastAllocator.hpp"
 #include "common/ThreadLocalPool.h"
 #include "common/tabletuple.h"
@@ -74,6 +75,20 @@ private:
     char m_data[3];
 };
 
+/**
+ * The smallest and largest value of a column over the tuples of a block.
+ * A new range is empty, with its minimum above its maximum.
+ */
+struct ZoneRange {
+    ZoneRange()
+      : m_min(std::numeric_limits<int64_t>::max()), m_max(std::numeric_limits<int64_t>::min())
+    {
+    }
+
+    int64_t m_min;
+    int64_t m_max;
+};
+
 //typedef boost::shared_ptr<TupleBlock> TBPtr;
 typedef boost::intrusive_ptr<TupleBlock> TBPtr;
 //typedef TupleBlock* TBPtr;
@@ -192,6 +207,9 @@ public:
     inline int freeTuple(char *tupleStorage) {
         m_lastCompactionOffset = 0;
         m_activeTuples--;
+        if (m_activeTuples == 0) {
+            resetZones();
+        }
         //Find the offset
         uint32_t offset = static_cast<uint32_t>(tupleStorage - m_storage);
         m_freeList.push_back(offset);
@@ -212,6 +230,7 @@ public:
         m_activeTuples = 0;
         m_nextFreeTuple = 0;
         m_freeList.clear();
+        resetZones();
     }
 
     inline uint32_t unusedTupleBoundry() {
@@ -235,7 +254,48 @@ public:
     inline TBBucketPtr currentBucket() {
         return m_bucket;
     }
+
+    /*
+     * Zone maps: for each column the table keeps one for, the range of
+     * the values stored in the block since it was last empty. Deletes and
+     * updates never narrow a range, so it may be wider than the values
+     * left in the block, but never narrower.
+     */
+    inline void addZone(const ZoneRange &range) {
+        m_zones.push_back(range);
+    }
+
+    inline void widenZone(std::size_t slot, int64_t value) {
+        ZoneRange &range = m_zones[slot];
+        if (value < range.m_min) {
+            range.m_min = value;
+        }
+        if (value > range.m_max) {
+            range.m_max = value;
+        }
+    }
+
+    inline void widenZones(const TupleBlock &other) {
+        assert(m_zones.size() == other.m_zones.size());
+        for (std::size_t slot = 0; slot < m_zones.size(); ++slot) {
+            if (other.m_zones[slot].m_min <= other.m_zones[slot].m_max) {
+                widenZone(slot, other.m_zones[slot].m_min);
+                widenZone(slot, other.m_zones[slot].m_max);
+            }
+        }
+    }
+
+    inline bool zoneOverlaps(std::size_t slot, int64_t low, int64_t high) const {
+        return m_zones[slot].m_min <= high && m_zones[slot].m_max >= low;
+    }
+
 private:
+    inline void resetZones() {
+        for (std::size_t slot = 0; slot < m_zones.size(); ++slot) {
+            m_zones[slot] = ZoneRange();
+        }
+    }
+
     char*   m_storage;
     uint32_t m_references;
     uint32_t m_tupleLength;
@@ -255,6 +315,41 @@ private:
 
     TBBucketPtr m_bucket;
     int m_bucketIndex;
+    const bool m_mappedStorage;
+    std::vector<ZoneRange> m_zones;
+};
+
+/**
+ * Ranges of zone mapped columns that hold every tuple a scan is looking
+ * for, so that it can pass over the blocks whose zones lie outside them.
+ */
+class ZoneMapFilter {
+public:
+    void restrict(std::size_t slot, int64_t low, int64_t high) {
+        SlotRange range = { slot, low, high };
+        m_ranges.push_back(range);
+    }
+
+    bool isEmpty() const {
+        return m_ranges.empty();
+    }
+
+    bool mayMatch(const TupleBlock &block) const {
+        for (std::size_t ii = 0; ii < m_ranges.size(); ++ii) {
+            if (!block.zoneOverlaps(m_ranges[ii].m_slot, m_ranges[ii].m_low, m_ranges[ii].m_high)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    struct SlotRange {
+        std::size_t m_slot;
+        int64_t m_low;
+        int64_t m_high;
+    };
+    std::vector<SlotRange> m_ranges;
 };
 
 /**
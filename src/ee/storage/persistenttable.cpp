@@ -123,6 +123,7 @@ PersistentTable::PersistentTable(int partitionColumn, const char * signature, bo
     m_stats(this),
     m_failedCompactionCount(0),
     m_invisibleTuplesPendingDeleteCount(0),
+    m_auxiliaryMemorySize(0),
     m_surgeon(*this),
     m_isMaterialized(isMaterialized),
     m_drEnabled(drEnabled),
@@ -291,6 +292,48 @@ void PersistentTable::nextFreeTuple(TableTuple *tuple) {
     }
 }
 
+int PersistentTable::zoneMapSlot(int column) {
+    for (std::size_t slot = 0; slot < m_zoneMapColumns.size(); ++slot) {
+        if (m_zoneMapColumns[slot] == column) {
+            return static_cast<int>(slot);
+        }
+    }
+    if (m_zoneMapColumns.size() >= MAX_ZONE_MAP_COLUMNS) {
+        return -1;
+    }
+    switch (m_schema->columnType(column)) {
+    case VALUE_TYPE_TINYINT:
+    case VALUE_TYPE_SMALLINT:
+    case VALUE_TYPE_INTEGER:
+    case VALUE_TYPE_BIGINT:
+    case VALUE_TYPE_TIMESTAMP:
+        break;
+    default:
+        return -1;
+    }
+
+    // Start the new zone maps from every tuple stored, including the ones
+    // pending delete, which an undo may bring back.
+    const std::size_t slot = m_zoneMapColumns.size();
+    m_zoneMapColumns.push_back(column);
+    TableTuple tuple(m_schema);
+    for (TBMapI iter = m_data.begin(); iter != m_data.end(); ++iter) {
+        TBPtr block = iter.data();
+        block->addZone(ZoneRange());
+        char *tupleData = block->address();
+        for (uint32_t ii = 0; ii < block->unusedTupleBoundry(); ++ii, tupleData += m_tupleLength) {
+            tuple.move(tupleData);
+            if (tuple.isActive()) {
+                const NValue value = tuple.getNValue(column);
+                if (!value.isNull()) {
+                    block->widenZone(slot, ValuePeeker::peekAsBigInt(value));
+                }
+            }
+        }
+    }
+    return static_cast<int>(slot);
+}
+
 void PersistentTable::deleteAllTuples(bool, bool fallible) {
     // Instead of recording each tuple deletion, log it as a table truncation DR.
     ExecutorContext *ec = ExecutorContext::getExecutorContext();
@@ -312,11 +355,13 @@ void PersistentTable::deleteAllTuples(bool, bool fallible) {
     DRTupleStreamDisableGuard drGuard(ec, false);
 
     // nothing interesting
+    ScopedDeferredViewUpdates deferredViewUpdates(this);
     TableIterator ti(this, m_data.begin());
     TableTuple tuple(m_schema);
     while (ti.next(tuple)) {
         deleteTuple(tuple, fallible);
     }
+    deferredViewUpdates.apply();
 }
 
 void PersistentTable::truncateTableForUndo(VoltDBEngine * engine, TableCatalogDelegate * tcd,
@@ -683,6 +728,7 @@ void PersistentTable::insertTupleCommon(TableTuple &source, TableTuple &target,
     target.setActiveTrue();
     target.setPendingDeleteFalse();
     target.setPendingDeleteOnUndoReleaseFalse();
+    widenZoneMaps(target);
 
     /**
      * Inserts never "dirty" a tuple since the tuple is new, but...  The
@@ -756,6 +802,96 @@ void PersistentTable::insertTupleForUndo(char *tuple) {
     }
 }
 
+// Changed byte ranges closer than this are recorded as one, since each
+// range costs 8 bytes of bookkeeping.
+static const int32_t UPDATE_UNDO_MERGE_GAP = 8;
+
+/*
+ * Call visitor(offset, length) for each run of bytes that differ between
+ * the column data of two tuples with the same schema.
+ */
+template <typename Visitor>
+static void forEachChangedRange(const TableTuple &before, const TableTuple &after, Visitor visitor) {
+    const char* beforeData = before.address() + TUPLE_HEADER_SIZE;
+    const char* afterData = after.address() + TUPLE_HEADER_SIZE;
+    const int32_t length = before.getSchema()->tupleLength();
+    int32_t ii = 0;
+    while (ii < length) {
+        if (beforeData[ii] == afterData[ii]) {
+            ++ii;
+            continue;
+        }
+        const int32_t start = ii;
+        int32_t end = ii + 1;
+        for (ii = end; ii < length && ii - end < UPDATE_UNDO_MERGE_GAP; ++ii) {
+            if (beforeData[ii] != afterData[ii]) {
+                end = ii + 1;
+            }
+        }
+        visitor(start, end - start);
+    }
+}
+
+// Sizes the record copyChangedValues makes.
+struct ChangedRangeSizer {
+    ChangedRangeSizer(int32_t &rangeCount, size_t &size) : m_rangeCount(rangeCount), m_size(size) { }
+    void operator()(int32_t offset, int32_t length) {
+        ++m_rangeCount;
+        m_size += 2 * sizeof(int32_t) + length;
+    }
+    int32_t &m_rangeCount;
+    size_t &m_size;
+};
+
+// Appends each range's offset, length and bytes to the record.
+struct ChangedRangeCopier {
+    ChangedRangeCopier(const char* data, char* &cursor) : m_data(data), m_cursor(cursor) { }
+    void operator()(int32_t offset, int32_t length) {
+        ::memcpy(m_cursor, &offset, sizeof(int32_t));
+        ::memcpy(m_cursor + sizeof(int32_t), &length, sizeof(int32_t));
+        ::memcpy(m_cursor + 2 * sizeof(int32_t), m_data + offset, length);
+        m_cursor += 2 * sizeof(int32_t) + length;
+    }
+    const char* m_data;
+    char* &m_cursor;
+};
+
+/*
+ * Copy the bytes of target that an update to source's values would change
+ * into the undo pool: a range count, then the offset, length and bytes of
+ * each range.
+ */
+static char* copyChangedValues(UndoQuantum *uq, const TableTuple &target, const TableTuple &source) {
+    int32_t rangeCount = 0;
+    size_t size = sizeof(int32_t);
+    forEachChangedRange(target, source, ChangedRangeSizer(rangeCount, size));
+
+    char* oldValues = uq->allocatePooled(size);
+    ::memcpy(oldValues, &rangeCount, sizeof(int32_t));
+    char* cursor = oldValues + sizeof(int32_t);
+    forEachChangedRange(target, source,
+                        ChangedRangeCopier(target.address() + TUPLE_HEADER_SIZE, cursor));
+    return oldValues;
+}
+
+/*
+ * Put back the bytes saved by copyChangedValues.
+ */
+static void restoreChangedValues(TableTuple &target, const char* oldValues) {
+    char* targetData = target.address() + TUPLE_HEADER_SIZE;
+    int32_t rangeCount;
+    ::memcpy(&rangeCount, oldValues, sizeof(int32_t));
+    const char* cursor = oldValues + sizeof(int32_t);
+    for (int32_t ii = 0; ii < rangeCount; ++ii) {
+        int32_t offset;
+        int32_t length;
+        ::memcpy(&offset, cursor, sizeof(int32_t));
+        ::memcpy(&length, cursor + sizeof(int32_t), sizeof(int32_t));
+        ::memcpy(targetData + offset, cursor + 2 * sizeof(int32_t), length);
+        cursor += 2 * sizeof(int32_t) + length;
+    }
+}
+
 /*
  * Regular tuple update function that does a copy and allocation for
  * updated strings and creates an UndoAction. Additional optimization
@@ -765,9 +901,9 @@ void PersistentTable::updateTupleWithSpecificIndexes(TableTuple &targetTupleToUp
                                                      TableTuple &sourceTupleWithNewValues,
                                                      std::vector<TableIndex*> const &indexesToUpdate,
                                                      bool fallible,
-                                                     bool updateDRTimestamp) {
+                                                     bool updateDRTimestamp,
+                                                     bool updateViews) {
     UndoQuantum *uq = NULL;
-    char* oldTupleData = NULL;
     int tupleLength = targetTupleToUpdate.tupleLength();
     /**
      * Check for index constraint violations.
@@ -793,13 +929,6 @@ void PersistentTable::updateTupleWithSpecificIndexes(TableTuple &targetTupleToUp
         }
 
         uq = ExecutorContext::currentUndoQuantum();
-        if (uq) {
-            /*
-             * For undo purposes, before making any changes, save a copy of the state of the tuple
-             * into the undo pool temp storage and hold onto it with oldTupleData.
-             */
-            oldTupleData = uq->allocatePooledCopy(targetTupleToUpdate.address(), targetTupleToUpdate.tupleLength());
-        }
     }
 
     // Write to the DR stream before doing anything else to ensure we don't
@@ -857,8 +986,8 @@ void PersistentTable::updateTupleWithSpecificIndexes(TableTuple &targetTupleToUp
     //
     // Note that this is guaranteed to succeed, since we are inserting an existing tuple
     // (soon to be deleted) into the delta table.
-    insertTupleIntoDeltaTable(targetTupleToUpdate, fallible);
-    {
+    if (updateViews) {
+        insertTupleIntoDeltaTable(targetTupleToUpdate, fallible);
         SetAndRestorePendingDeleteFlag setPending(targetTupleToUpdate);
         BOOST_FOREACH (auto viewHandler, m_viewHandlers) {
             viewHandler->handleTupleDelete(this, fallible);
@@ -897,16 +1026,25 @@ void PersistentTable::updateTupleWithSpecificIndexes(TableTuple &targetTupleToUp
     std::vector<char*> oldObjects;
     std::vector<char*> newObjects;
 
+    // For undo purposes, before the tuple changes, save the bytes that are about to change.
+    // Nothing has written the tuple's column data up to here.
+    char* oldValues = NULL;
+    if (uq) {
+        oldValues = copyChangedValues(uq, targetTupleToUpdate, sourceTupleWithNewValues);
+    }
+
     // this is the actual write of the new values
     targetTupleToUpdate.copyForPersistentUpdate(sourceTupleWithNewValues, oldObjects, newObjects);
+    widenZoneMaps(targetTupleToUpdate);
 
     if (uq) {
         /*
-         * Create and register an undo action with copies of the "before" and "after" tuple storage
-         * and the "before" and "after" object pointers for non-inlined columns that changed.
+         * Create and register an undo action with a copy of the "after" tuple storage, the
+         * "before" bytes that changed, and the "before" and "after" object pointers for
+         * non-inlined columns that changed.
          */
         char* newTupleData = uq->allocatePooledCopy(targetTupleToUpdate.address(), tupleLength);
-        uq->registerUndoAction(new (*uq) PersistentTableUndoUpdateAction(oldTupleData, newTupleData,
+        uq->registerUndoAction(new (*uq) PersistentTableUndoUpdateAction(newTupleData, oldValues,
                                                                          oldObjects, newObjects,
                                                                          &m_surgeon, someIndexGotUpdated));
     }
@@ -934,6 +1072,10 @@ void PersistentTable::updateTupleWithSpecificIndexes(TableTuple &targetTupleToUp
         }
     }
 
+    if ( ! updateViews) {
+        return;
+    }
+
     // Note that inserting into the delta table is guaranteed to
     // succeed, since we checked constraints above.
     insertTupleIntoDeltaTable(targetTupleToUpdate, fallible);
@@ -947,29 +1089,33 @@ void PersistentTable::updateTupleWithSpecificIndexes(TableTuple &targetTupleToUp
     }
 }
 
+bool PersistentTable::viewsDependOnColumns(const std::vector<bool> &columns) const {
+    if ( ! m_viewHandlers.empty()) {
+        return true;
+    }
+    BOOST_FOREACH(MaterializedViewTriggerForWrite *view, m_views) {
+        if (view->dependsOnColumns(columns)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 /*
- * sourceTupleWithNewValues contains a copy of the tuple data before the update
- * and tupleWithUnwantedValues contains a copy of the updated tuple data.
+ * tupleWithUnwantedValues contains a copy of the updated tuple data and
+ * oldValues the bytes of it that the update changed, as they were before.
  * First remove the current tuple value from any indexes (if asked to do so).
- * Then revert the tuple to the original preupdate values by copying the source to the target.
+ * Then revert the tuple to the original preupdate values by putting back the changed bytes.
  * Then insert the new (or rather, old) value back into the indexes.
  */
 void PersistentTable::updateTupleForUndo(char* tupleWithUnwantedValues,
-                                         char* sourceTupleDataWithNewValues,
+                                         const char* oldValues,
                                          bool revertIndexes) {
-    TableTuple matchable(m_schema);
-    // Get the address of the tuple in the table from one of the copies on hand.
-    // Any TableScan OR a primary key lookup on an already updated index will find the tuple
-    // by its unwanted updated values.
-    if (revertIndexes || primaryKeyIndex() == NULL) {
-        matchable.move(tupleWithUnwantedValues);
-    }
-    // A primary key lookup on a not-yet-updated index will find the tuple by its original/new values.
-    else {
-        matchable.move(sourceTupleDataWithNewValues);
-    }
+    // Get the address of the tuple in the table from the copy on hand.
+    // Any TableScan OR a primary key lookup will find the tuple by its unwanted updated values:
+    // if the indexes were not updated, the primary key did not change.
+    TableTuple matchable(tupleWithUnwantedValues, m_schema);
     TableTuple targetTupleToUpdate = lookupTupleForUndo(matchable);
-    TableTuple sourceTupleWithNewValues(sourceTupleDataWithNewValues, m_schema);
 
     //If the indexes were never updated there is no need to revert them.
     if (revertIndexes) {
@@ -981,19 +1127,18 @@ void PersistentTable::updateTupleForUndo(char* tupleWithUnwantedValues,
         }
     }
 
-    if (m_schema->getUninlinedObjectColumnCount() != 0) {
+    const bool hasObjects = m_schema->getUninlinedObjectColumnCount() != 0;
+    if (hasObjects) {
         decreaseStringMemCount(targetTupleToUpdate.getNonInlinedMemorySize());
-        increaseStringMemCount(sourceTupleWithNewValues.getNonInlinedMemorySize());
     }
 
-    bool dirty = targetTupleToUpdate.isDirty();
-    // this is the actual in-place revert to the old version
-    targetTupleToUpdate.copy(sourceTupleWithNewValues);
-    if (dirty) {
-        targetTupleToUpdate.setDirtyTrue();
-    }
-    else {
-        targetTupleToUpdate.setDirtyFalse();
+    // this is the actual in-place revert to the old version, which leaves the tuple flags alone
+    restoreChangedValues(targetTupleToUpdate, oldValues);
+    // The old values may predate the zone maps of the block.
+    widenZoneMaps(targetTupleToUpdate);
+
+    if (hasObjects) {
+        increaseStringMemCount(targetTupleToUpdate.getNonInlinedMemorySize());
     }
 
     //If the indexes were never updated there is no need to revert them.
@@ -1290,6 +1435,27 @@ void PersistentTable::addMaterializedView(MaterializedViewTriggerForWrite* view)
     m_views.push_back(view);
 }
 
+void PersistentTable::deferViewUpdates() {
+    BOOST_FOREACH(MaterializedViewTriggerForWrite* view, m_views) {
+        view->deferUpdates();
+    }
+}
+
+void PersistentTable::applyDeferredViewUpdates() {
+    for (size_t ii = 0; ii < m_views.size(); ++ii) {
+        try {
+            m_views[ii]->applyDeferredUpdates();
+        }
+        catch (...) {
+            // The statement is failing; don't leave the other views deferring.
+            for (size_t jj = ii + 1; jj < m_views.size(); ++jj) {
+                m_views[jj]->discardDeferredUpdates();
+            }
+            throw;
+        }
+    }
+}
+
 /*
  * drop a view. the table is no longer feeding it.
  * The destination table will go away when the view metadata is deleted (or later?) as its refcount goes to 0.
@@ -1385,6 +1551,156 @@ void PersistentTable::processLoadedTuple(TableTuple &tuple,
     }
 }
 
+/*
+ * The bulk path is only taken when the deferred index build can reject
+ * exactly the tuples the per-tuple path would have rejected, i.e. when at
+ * most one index can raise a unique violation, and when no streaming
+ * context or join view needs to observe each insert as it happens.
+ */
+bool PersistentTable::beginBulkLoad(int tupleCount) {
+    if (m_tableStreamer != NULL || m_deltaTable != NULL ||
+        ! m_viewHandlers.empty() || m_uniqueIndexes.size() > 1) {
+        return false;
+    }
+    assert(m_bulkLoadTuples.empty());
+    m_bulkLoadTuples.reserve(tupleCount);
+    return true;
+}
+
+void PersistentTable::processBulkLoadedTuple(TableTuple &tuple,
+                                             ReferenceSerializeOutput *uniqueViolationOutput,
+                                             int32_t &serializedTupleCount,
+                                             size_t &tupleCountPosition) {
+    // Accounted up front so that deleteTupleStorage balances on every exit path.
+    if (m_schema->getUninlinedObjectColumnCount() != 0) {
+        increaseStringMemCount(tuple.getNonInlinedMemorySize());
+    }
+    widenZoneMaps(tuple);
+    if (checkNulls(tuple)) {
+        m_bulkLoadTuples.push_back(tuple.address());
+        return;
+    }
+    handleLoadedTupleViolation(tuple, TableTuple(), CONSTRAINT_TYPE_NOT_NULL,
+                               uniqueViolationOutput, serializedTupleCount, tupleCountPosition);
+}
+
+void PersistentTable::finishBulkLoad(ReferenceSerializeOutput *uniqueViolationOutput,
+                                     int32_t &serializedTupleCount,
+                                     size_t &tupleCountPosition,
+                                     bool shouldDRStreamRows) {
+    std::vector<char*> loaded;
+    loaded.swap(m_bulkLoadTuples);
+    // The conflicting table tuple for each loaded tuple a unique index rejected.
+    std::vector<char*> conflicts(loaded.size(), NULL);
+    TableTuple tuple(m_schema);
+    TableTuple conflict(m_schema);
+
+    // Build the (single) unique index first so that the tuples it rejects never
+    // reach the other indexes.
+    std::vector<TableIndex*> buildOrder(m_uniqueIndexes);
+    BOOST_FOREACH(TableIndex *index, m_indexes) {
+        if ( ! index->isUniqueIndex()) {
+            buildOrder.push_back(index);
+        }
+    }
+    BOOST_FOREACH(TableIndex *index, buildOrder) {
+        index->ensureCapacity(static_cast<uint32_t>(index->getSize() + loaded.size()));
+        for (size_t ii = 0; ii < loaded.size(); ++ii) {
+            if (conflicts[ii] != NULL) {
+                continue;
+            }
+            tuple.move(loaded[ii]);
+            index->addEntry(&tuple, &conflict);
+            if ( ! conflict.isNullTuple()) {
+                conflicts[ii] = conflict.address();
+                conflict.move(NULL);
+            }
+        }
+    }
+
+    ExecutorContext *ec = ExecutorContext::getExecutorContext();
+    AbstractDRTupleStream *drStream = getDRTupleStream(ec);
+    bool shouldDRStream = drStream && !m_isMaterialized && m_drEnabled && shouldDRStreamRows;
+    UndoQuantum *uq = ExecutorContext::currentUndoQuantum();
+    // Tuples from this position on are still only partially inserted and
+    // must be taken back out of the table if anything below throws.
+    size_t unfinished = 0;
+    ScopedDeferredViewUpdates deferredViewUpdates(this);
+    try {
+        for (size_t ii = 0; ii < loaded.size(); ++ii) {
+            tuple.move(loaded[ii]);
+            if (conflicts[ii] != NULL) {
+                // As in the per-tuple path, a reported tuple is left to the exception.
+                unfinished = ii + 1;
+                conflict.move(conflicts[ii]);
+                handleLoadedTupleViolation(tuple, conflict, CONSTRAINT_TYPE_UNIQUE,
+                                           uniqueViolationOutput, serializedTupleCount, tupleCountPosition);
+                continue;
+            }
+
+            if (hasDRTimestampColumn()) {
+                setDRTimestampForTuple(ec, tuple, false);
+            }
+            if (shouldDRStream) {
+                size_t drMark = drStream->appendTuple(ec->lastCommittedSpHandle(), m_signature, m_partitionColumn,
+                                                      ec->currentSpHandle(), ec->currentUniqueId(),
+                                                      tuple, DR_RECORD_INSERT);
+                if (uq) {
+                    uq->registerUndoAction(new (*uq) DRTupleStreamUndoAction(drStream, drMark, rowCostForDRRecord(DR_RECORD_INSERT)));
+                }
+            }
+
+            unfinished = ii + 1;
+            if (uq) {
+                char* tupleData = uq->allocatePooledCopy(tuple.address(), tuple.tupleLength());
+                uq->registerUndoAction(new (*uq) PersistentTableUndoInsertAction(tupleData, &m_surgeon));
+            }
+
+            for (int i = 0; i < m_views.size(); i++) {
+                m_views[i]->processTupleInsert(tuple, true);
+            }
+        }
+    }
+    catch (...) {
+        for (size_t ii = unfinished; ii < loaded.size(); ++ii) {
+            tuple.move(loaded[ii]);
+            if (conflicts[ii] == NULL) {
+                deleteFromAllIndexes(&tuple);
+            }
+            deleteTupleStorage(tuple);
+        }
+        throw;
+    }
+    deferredViewUpdates.apply();
+}
+
+void PersistentTable::abortBulkLoad() {
+    TableTuple tuple(m_schema);
+    BOOST_FOREACH(char *tupleData, m_bulkLoadTuples) {
+        tuple.move(tupleData);
+        deleteTupleStorage(tuple);
+    }
+    m_bulkLoadTuples.clear();
+}
+
+void PersistentTable::handleLoadedTupleViolation(TableTuple &tuple,
+                                                 TableTuple conflict,
+                                                 ConstraintType type,
+                                                 ReferenceSerializeOutput *uniqueViolationOutput,
+                                                 int32_t &serializedTupleCount,
+                                                 size_t &tupleCountPosition) {
+    if ( ! uniqueViolationOutput) {
+        throw ConstraintFailureException(this, tuple, conflict, type);
+    }
+    if (serializedTupleCount == 0) {
+        serializeColumnHeaderTo(*uniqueViolationOutput);
+        tupleCountPosition = uniqueViolationOutput->reserveBytes(sizeof(int32_t));
+    }
+    serializedTupleCount++;
+    tuple.serializeTo(*uniqueViolationOutput);
+    deleteTupleStorage(tuple);
+}
+
 /** Prepare table for streaming from serialized data. */
 bool PersistentTable::activateStream(
     TupleSerializer &tupleSerializer,
@@ -1981,6 +2297,46 @@ void PersistentTable::configureIndexStats() {
     }
 }
 
+bool PersistentTable::relaxSchemaInPlace(const TupleSchema *relaxedSchema) {
+    if ( ! m_schema->canRelaxTo(relaxedSchema)) {
+        return false;
+    }
+    if (m_deltaTable && ! m_deltaTable->m_schema->canRelaxTo(relaxedSchema)) {
+        return false;
+    }
+
+    std::vector<bool> changed(m_schema->columnCount(), false);
+    bool anyChanged = false;
+    for (int ii = 0; ii < m_schema->columnCount(); ++ii) {
+        const TupleSchema::ColumnInfo *columnInfo = m_schema->getColumnInfo(ii);
+        const TupleSchema::ColumnInfo *relaxedInfo = relaxedSchema->getColumnInfo(ii);
+        changed[ii] = columnInfo->length != relaxedInfo->length ||
+                      columnInfo->allowNull != relaxedInfo->allowNull;
+        anyChanged = anyChanged || changed[ii];
+    }
+    if ( ! anyChanged) {
+        return true;
+    }
+
+    BOOST_FOREACH(TableIndex *index, m_indexes) {
+        // Expressions and predicates may read any column.
+        if ( ! index->getIndexedExpressions().empty() || index->isPartialIndex()) {
+            return false;
+        }
+        BOOST_FOREACH(int columnIndex, index->getColumnIndices()) {
+            if (changed[columnIndex]) {
+                return false;
+            }
+        }
+    }
+
+    m_schema->relaxTo(relaxedSchema);
+    if (m_deltaTable) {
+        m_deltaTable->m_schema->relaxTo(relaxedSchema);
+    }
+    return true;
+}
+
 void PersistentTable::addViewHandler(MaterializedViewHandler *viewHandler) {
     if (m_viewHandlers.size() == 0) {
         VoltDBEngine *engine = ExecutorContext::getEngine();
@@ -57,6 +57,7 @@
 #include "common/ids.h"
 #include "common/valuevector.h"
 #include "common/tabletuple.h"
+#include "common/ValuePeeker.hpp"
 #include "execution/VoltDBEngine.h"
 #include "storage/CopyOnWriteIterator.h"
 #include "storage/ElasticIndex.h"
@@ -99,8 +100,8 @@ public:
     TBMap &getData() const;
     PersistentTable& getTable();
     void insertTupleForUndo(char *tuple);
-    void updateTupleForUndo(char* targetTupleToUpdate,
-                            char* sourceTupleWithNewValues,
+    void updateTupleForUndo(char* tupleWithUnwantedValues,
+                            const char* oldValues,
                             bool revertIndexes);
     // The fallible flag is used to denote a change to a persistent table
     // which is part of a long transaction that has been vetted and can
@@ -240,6 +241,16 @@ public:
         return m_iter;
     }
 
+    /**
+     * The zone map slot of a column, starting zone maps for it on the
+     * first request. Returns -1 for columns that can't have one, which
+     * are those not of an integer or timestamp type, and any beyond the
+     * first MAX_ZONE_MAP_COLUMNS requested.
+     */
+    int zoneMapSlot(int column);
+
+    std::size_t zoneMapColumnCount() const { return m_zoneMapColumns.size(); }
+
     JumpingTableIterator* makeJumpingIterator() {
         return new JumpingTableIterator(this, m_data.begin(), m_data.end());
     }
@@ -278,12 +289,15 @@ public:
     // The initial use case is a live catalog update that changes table schema and migrates tuples
     // and/or adds a materialized view.
     // Constraint checks are bypassed and the change does not make use of "undo" support.
+    // The updateViews flag can be cleared by callers that know (see viewsDependOnColumns)
+    // that the update changes nothing the materialized views read.
     // TODO: change meaningless bool return type to void (starting in class Table) and migrate callers.
     void updateTupleWithSpecificIndexes(TableTuple &targetTupleToUpdate,
                                         TableTuple &sourceTupleWithNewValues,
                                         std::vector<TableIndex*> const &indexesToUpdate,
                                         bool fallible=true,
-                                        bool updateDRTimestamp=true);
+                                        bool updateDRTimestamp=true,
+                                        bool updateViews=true);
 
     // ------------------------------------------------------------------
     // INDEXES
@@ -305,6 +319,15 @@ public:
 
     void configureIndexStats();
 
+    /**
+     * Take on a schema that keeps the tuple format, such as one with a
+     * wider out-of-line column or a column that now allows nulls, without
+     * copying any tuples. Returns false and leaves the table alone if the
+     * change needs a rebuild: the format differs, or an index covers a
+     * changed column, since index keys carry their own column metadata.
+     */
+    bool relaxSchemaInPlace(const TupleSchema *relaxedSchema);
+
     // mutating indexes
     void addIndex(TableIndex *index);
     void removeIndex(TableIndex *index);
@@ -370,6 +393,21 @@ public:
 
     std::vector<MaterializedViewTriggerForWrite*>& views() { return m_views; }
 
+    /**
+     * Whether an update of the flagged columns could change any materialized
+     * view of this table. Views joining this table with others are assumed
+     * to depend on every column.
+     */
+    bool viewsDependOnColumns(const std::vector<bool> &columns) const;
+
+    /**
+     * Have the single-table views sum up the changes of a multi-row statement
+     * per view group and write them once per group in applyDeferredViewUpdates.
+     * Use ScopedDeferredViewUpdates rather than calling these directly.
+     */
+    void deferViewUpdates();
+    void applyDeferredViewUpdates();
+
     TableTuple& copyIntoTempTuple(TableTuple &source) {
         assert (m_tempTuple.m_data);
         m_tempTuple.copy(source);
@@ -422,6 +460,22 @@ public:
         m_nonInlinedMemorySize -= bytes;
     }
 
+    void increaseAuxiliaryMemCount(size_t bytes) {
+        m_auxiliaryMemorySize += bytes;
+    }
+
+    void decreaseAuxiliaryMemCount(size_t bytes) {
+        m_auxiliaryMemorySize -= bytes;
+    }
+
+    int64_t auxiliaryMemorySize() const {
+        return m_auxiliaryMemorySize;
+    }
+
+    int64_t allocatedTupleMemory() const {
+        return Table::allocatedTupleMemory() + m_auxiliaryMemorySize;
+    }
+
     size_t allocatedBlockCount() const {
         return m_data.size();
     }
@@ -608,8 +662,8 @@ private:
     // handled.
     void insertTupleCommon(TableTuple &source, TableTuple &target, bool fallible, bool shouldDRStream = true);
     void insertTupleForUndo(char *tuple);
-    void updateTupleForUndo(char* targetTupleToUpdate,
-                            char* sourceTupleWithNewValues,
+    void updateTupleForUndo(char* tupleWithUnwantedValues,
+                            const char* oldValues,
                             bool revertIndexes);
     void deleteTupleForUndo(char* tupleData, bool skipLookup = false);
     void deleteTupleRelease(char* tuple);
@@ -630,6 +684,29 @@ private:
                                     size_t &tupleCountPosition,
                                     bool shouldDRStreamRows);
 
+    /*
+     * Bulk load path for Table::loadTuplesFrom. Loaded tuples are only
+     * checked for nulls as they arrive; indexes are then built one index at
+     * a time over the whole batch, after which the surviving tuples are
+     * DR streamed, registered for undo and fed to the views.
+     */
+    virtual bool beginBulkLoad(int tupleCount);
+    virtual void processBulkLoadedTuple(TableTuple &tuple,
+                                        ReferenceSerializeOutput *uniqueViolationOutput,
+                                        int32_t &serializedTupleCount,
+                                        size_t &tupleCountPosition);
+    virtual void finishBulkLoad(ReferenceSerializeOutput *uniqueViolationOutput,
+                                int32_t &serializedTupleCount,
+                                size_t &tupleCountPosition,
+                                bool shouldDRStreamRows);
+    virtual void abortBulkLoad();
+    void handleLoadedTupleViolation(TableTuple &tuple,
+                                    TableTuple conflict,
+                                    ConstraintType type,
+                                    ReferenceSerializeOutput *uniqueViolationOutput,
+                                    int32_t &serializedTupleCount,
+                                    size_t &tupleCountPosition);
+
     enum LookupType {
         LOOKUP_BY_VALUES,
         LOOKUP_FOR_DR,
@@ -639,6 +716,10 @@ private:
 
     TBPtr allocateNextBlock();
 
+    // Widen the zone maps of the tuple's block to cover its values.
+    void widenZoneMaps(const TableTuple &tuple);
+    void widenZoneMaps(TBPtr block, const TableTuple &tuple);
+
     inline AbstractDRTupleStream *getDRTupleStream(ExecutorContext *ec) {
         if (isReplicatedTable()) {
             return ec->drReplicatedStream();
@@ -706,6 +787,10 @@ private:
     // This is a testability feature not intended for use in product logic.
     int m_invisibleTuplesPendingDeleteCount;
 
+    // Memory held for this table outside its blocks and string pool,
+    // such as the MIN/MAX value sets kept for a materialized view.
+    int64_t m_auxiliaryMemorySize;
+
     // Surgeon passed to classes requiring "deep" access to avoid excessive friendship.
     PersistentTableSurgeon m_surgeon;
 
@@ -745,6 +830,50 @@ private:
     // (currently defined in MaterializedViewHandler.h) instead.
     PersistentTable *m_deltaTable;
     bool m_deltaTableActive;
+
+    // Tuples stored by an in-progress bulk load that are not yet indexed.
+    std::vector<char*> m_bulkLoadTuples;
+
+    // The columns with zone maps, in the order of their slots in each block.
+    std::vector<int> m_zoneMapColumns;
+    static const std::size_t MAX_ZONE_MAP_COLUMNS = 4;
+};
+
+/**
+ * Defers the view maintenance of a multi-row statement on a table until
+ * apply() is called. If the statement fails before that, the deferred
+ * changes are still written on the way out so that the views match the
+ * source rows the statement did change.
+ */
+class ScopedDeferredViewUpdates {
+public:
+    ScopedDeferredViewUpdates(PersistentTable *table)
+        : m_table(table && ! table->views().empty() ? table : NULL) {
+        if (m_table) {
+            m_table->deferViewUpdates();
+        }
+    }
+
+    ~ScopedDeferredViewUpdates() {
+        if (m_table) {
+            try {
+                m_table->applyDeferredViewUpdates();
+            }
+            catch (...) {
+                // The exception already in flight is the one to report.
+            }
+        }
+    }
+
+    void apply() {
+        PersistentTable *table = m_table;
+        m_table = NULL;
+        if (table) {
+            table->applyDeferredViewUpdates();
+        }
+    }
+private:
+    PersistentTable *m_table;
 };
 
 inline PersistentTableSurgeon::PersistentTableSurgeon(PersistentTable &table) :
@@ -764,10 +893,10 @@ inline void PersistentTableSurgeon::insertTupleForUndo(char *tuple) {
     m_table.insertTupleForUndo(tuple);
 }
 
-inline void PersistentTableSurgeon::updateTupleForUndo(char* targetTupleToUpdate,
-                                                       char* sourceTupleWithNewValues,
+inline void PersistentTableSurgeon::updateTupleForUndo(char* tupleWithUnwantedValues,
+                                                       const char* oldValues,
                                                        bool revertIndexes) {
-    m_table.updateTupleForUndo(targetTupleToUpdate, sourceTupleWithNewValues, revertIndexes);
+    m_table.updateTupleForUndo(tupleWithUnwantedValues, oldValues, revertIndexes);
 }
 
 inline void PersistentTableSurgeon::deleteTuple(TableTuple &tuple, bool fallible) {
@@ -1016,8 +1145,26 @@ inline TBPtr PersistentTable::findBlock(char *tuple, TBMap &blocks, int blockSiz
     return TBPtr(NULL);
 }
 
+inline void PersistentTable::widenZoneMaps(TBPtr block, const TableTuple &tuple) {
+    for (std::size_t slot = 0; slot < m_zoneMapColumns.size(); ++slot) {
+        const NValue value = tuple.getNValue(m_zoneMapColumns[slot]);
+        if (!value.isNull()) {
+            block->widenZone(slot, ValuePeeker::peekAsBigInt(value));
+        }
+    }
+}
+
+inline void PersistentTable::widenZoneMaps(const TableTuple &tuple) {
+    if (!m_zoneMapColumns.empty()) {
+        widenZoneMaps(findBlock(tuple.address(), m_data, m_tableAllocationSize), tuple);
+    }
+}
+
 inline TBPtr PersistentTable::allocateNextBlock() {
     TBPtr block(new TupleBlock(this, m_blocksNotPendingSnapshotLoad[0]));
+    for (std::size_t slot = 0; slot < m_zoneMapColumns.size(); ++slot) {
+        block->addZone(ZoneRange());
+    }
     m_data.insert(block->address(), block);
     m_blocksNotPendingSnapshot.insert(block);
     return block;
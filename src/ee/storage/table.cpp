@@ -456,16 +456,39 @@ void Table::loadTuplesFromNoHeader(SerializeInputBE &serialize_io,
     if (uniqueViolationOutput != NULL) {
         lengthPosition = uniqueViolationOutput->reserveBytes(4);
     }
-    for (int i = 0; i < tupleCount; ++i) {
-        nextFreeTuple(&target);
-        target.setActiveTrue();
-        target.setDirtyFalse();
-        target.setPendingDeleteFalse();
-        target.setPendingDeleteOnUndoReleaseFalse();
+    if (tupleCount > 1 && beginBulkLoad(tupleCount)) {
+        // Index and view maintenance is deferred to finishBulkLoad.
+        try {
+            for (int i = 0; i < tupleCount; ++i) {
+                nextFreeTuple(&target);
+                target.setActiveTrue();
+                target.setDirtyFalse();
+                target.setPendingDeleteFalse();
+                target.setPendingDeleteOnUndoReleaseFalse();
+
+                target.deserializeFrom(serialize_io, stringPool);
+
+                processBulkLoadedTuple(target, uniqueViolationOutput, serializedTupleCount, tupleCountPosition);
+            }
+        }
+        catch (...) {
+            abortBulkLoad();
+            throw;
+        }
+        finishBulkLoad(uniqueViolationOutput, serializedTupleCount, tupleCountPosition, shouldDRStreamRow);
+    }
+    else {
+        for (int i = 0; i < tupleCount; ++i) {
+            nextFreeTuple(&target);
+            target.setActiveTrue();
+            target.setDirtyFalse();
+            target.setPendingDeleteFalse();
+            target.setPendingDeleteOnUndoReleaseFalse();
 
-        target.deserializeFrom(serialize_io, stringPool);
+            target.deserializeFrom(serialize_io, stringPool);
 
-        processLoadedTuple(target, uniqueViolationOutput, serializedTupleCount, tupleCountPosition, shouldDRStreamRow);
+            processLoadedTuple(target, uniqueViolationOutput, serializedTupleCount, tupleCountPosition, shouldDRStreamRow);
+        }
     }
 
     //If unique constraints are being handled, write the length/size of constraints that occured
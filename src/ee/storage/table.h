@@ -308,6 +308,33 @@ protected:
                                     bool shouldDRStreamRow) {
     };
 
+    /*
+     * Bulk load hooks called by Table::loadTuplesFromNoHeader. A table that
+     * returns true from beginBulkLoad receives each deserialized tuple via
+     * processBulkLoadedTuple and may defer index and view maintenance until
+     * finishBulkLoad. abortBulkLoad releases any deferred tuples if the load
+     * fails part way through. The default is the per-tuple path.
+     */
+    virtual bool beginBulkLoad(int tupleCount) {
+        return false;
+    }
+
+    virtual void processBulkLoadedTuple(TableTuple &tuple,
+                                        ReferenceSerializeOutput *uniqueViolationOutput,
+                                        int32_t &serializedTupleCount,
+                                        size_t &tupleCountPosition) {
+        throwFatalException("Unsupported operation");
+    }
+
+    virtual void finishBulkLoad(ReferenceSerializeOutput *uniqueViolationOutput,
+                                int32_t &serializedTupleCount,
+                                size_t &tupleCountPosition,
+                                bool shouldDRStreamRows) {
+    }
+
+    virtual void abortBulkLoad() {
+    }
+
     virtual void swapTuples(TableTuple &sourceTupleWithNewValues, TableTuple &destinationTuple) {
         throwFatalException("Unsupported operation");
     }
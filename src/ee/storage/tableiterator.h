@@ -88,6 +88,15 @@ public:
         m_tempTableDeleteAsGo = flag;
     }
 
+    /**
+     * Pass over the persistent table blocks whose zone maps show they
+     * hold no tuple the filter may match. The filter must outlive the
+     * iteration.
+     */
+    void setZoneMapFilter(const ZoneMapFilter *filter) {
+        m_zoneMapFilter = filter;
+    }
+
 protected:
     // Get an iterator via table->iterator()
     TableIterator(Table *, TBMapI);
@@ -127,6 +136,7 @@ protected:
     std::vector<TBPtr>::iterator m_tempBlockIterator;
     bool m_tempTableIterator;
     bool m_tempTableDeleteAsGo;
+    const ZoneMapFilter *m_zoneMapFilter;
 };
 
 inline TableIterator::TableIterator(Table *parent, std::vector<TBPtr>::iterator start)
@@ -139,7 +149,8 @@ inline TableIterator::TableIterator(Table *parent, std::vector<TBPtr>::iterator
       m_tuplesPerBlock(parent->m_tuplesPerBlock), m_currentBlock(NULL),
       m_tempBlockIterator(start),
       m_tempTableIterator(true),
-      m_tempTableDeleteAsGo(false)
+      m_tempTableDeleteAsGo(false),
+      m_zoneMapFilter(NULL)
     {
     }
 
@@ -156,7 +167,8 @@ inline TableIterator::TableIterator(Table *parent, TBMapI start)
       m_tuplesPerBlock(parent->m_tuplesPerBlock),
       m_currentBlock(NULL),
       m_tempTableIterator(false),
-      m_tempTableDeleteAsGo(false)
+      m_tempTableDeleteAsGo(false),
+      m_zoneMapFilter(NULL)
     {
     }
 
@@ -171,7 +183,8 @@ inline TableIterator::TableIterator(Table *parent)
       m_tuplesPerBlock(1),
       m_currentBlock(NULL),
       m_tempTableIterator(true),
-      m_tempTableDeleteAsGo(false)
+      m_tempTableDeleteAsGo(false),
+      m_zoneMapFilter(NULL)
     {
     }
 
@@ -188,6 +201,7 @@ inline void TableIterator::reset(std::vector<TBPtr>::iterator start) {
     m_currentBlock = NULL;
     m_tempTableIterator = true;
     m_tempTableDeleteAsGo = false;
+    m_zoneMapFilter = NULL;
 }
 
 inline void TableIterator::reset(TBMapI start) {
@@ -202,6 +216,7 @@ inline void TableIterator::reset(TBMapI start) {
     m_currentBlock = NULL;
     m_tempTableIterator = false;
     m_tempTableDeleteAsGo = false;
+    m_zoneMapFilter = NULL;
 }
 
 inline bool TableIterator::hasNext() {
@@ -229,6 +244,13 @@ inline bool TableIterator::persistentNext(TableTuple &out) {
             m_currentBlock = m_blockIterator.data();
             m_blockOffset = 0;
             m_blockIterator++;
+            if (m_zoneMapFilter != NULL && !m_zoneMapFilter->mayMatch(*m_currentBlock)) {
+                // Count the block's tuples as found and move on to the next one.
+                m_foundTuples += m_currentBlock->activeTuples();
+                m_location += m_currentBlock->unusedTupleBoundry();
+                m_blockOffset = m_currentBlock->unusedTupleBoundry();
+                continue;
+            }
         } else {
             m_dataPtr += m_tupleLength;
         }
@@ -59,6 +59,16 @@ class TableColumn;
 class TableFactory;
 class TableStats;
 
+/**
+ * Receives the tuples inserted into a temp table that has been
+ * pipelined into its consumer, see TempTable::setPipelineSink.
+ */
+class TempTableTupleSink {
+  public:
+    virtual ~TempTableTupleSink() {}
+    virtual void pushTuple(TableTuple &tuple) = 0;
+};
+
 /**
  * Represents a Temporary Table to store temporary result (final
  * result or intermediate result).  Temporary Table has no indexes,
@@ -127,6 +137,18 @@ class TempTable : public Table {
 
     int64_t tempTableTupleCount() const { return m_tupleCount; }
 
+    /**
+     * Hand every tuple later passed to insertTempTuple straight to sink
+     * instead of storing it, so that the table stays empty. Used when the
+     * only reader of the table can consume its tuples as they are produced.
+     */
+    void setPipelineSink(TempTableTupleSink* sink) { m_pipelineSink = sink; }
+
+    bool isPipelined() const { return m_pipelineSink != NULL; }
+
+    /** How many tuples have been handed to the sink since the table was created. */
+    int64_t pipelinedTupleCount() const { return m_pipelinedTupleCount; }
+
     // ------------------------------------------------------------------
     // INDEXES
     // ------------------------------------------------------------------
@@ -165,6 +187,10 @@ class TempTable : public Table {
   private:
     // pointers to chunks of data. Specific to table impl. Don't leak this type.
     std::vector<TBPtr> m_data;
+
+    // if set, the consumer that inserted tuples are pushed to
+    TempTableTupleSink* m_pipelineSink;
+    int64_t m_pipelinedTupleCount;
 };
 
 inline void TempTable::insertTempTupleDeepCopy(const TableTuple &source, Pool *pool) {
@@ -184,6 +210,12 @@ inline void TempTable::insertTempTupleDeepCopy(const TableTuple &source, Pool *p
 }
 
 inline void TempTable::insertTempTuple(TableTuple &source) {
+    if (m_pipelineSink != NULL) {
+        ++m_pipelinedTupleCount;
+        m_pipelineSink->pushTuple(source);
+        return;
+    }
+
     //
     // First get the next free tuple
     // This will either give us one from the free slot list, or
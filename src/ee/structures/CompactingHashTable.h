@@ -162,6 +162,8 @@ namespace voltdb {
         iterator find(const Key &key) const;
         /** find an exact key/value match (optionaly searching by value first) */
         iterator find(const Key &key, const Data &value) const;
+        /** start loading the bucket a find of this key will read */
+        void prefetch(const Key &key) const;
         /** simple insert */
         const Data *insert(const Key &key, const Data &value);
         /** delete by key (unique only) */
@@ -293,6 +295,13 @@ namespace voltdb {
         return iterator(foundNode);
     }
 
+    template<class K, class T, class H, class EK, class ET>
+    void CompactingHashTable<K, T, H, EK, ET>::prefetch(const Key &key) const {
+        uint64_t hash = m_hasher(key);
+        uint64_t bucketOffset = hash % TABLE_SIZES[m_sizeIndex];
+        __builtin_prefetch(&m_buckets[bucketOffset]);
+    }
+
     template<class K, class T, class H, class EK, class ET>
     typename CompactingHashTable<K, T, H, EK, ET>::iterator CompactingHashTable<K, T, H, EK, ET>::find(const Key &key, const Data &value) const {
         uint64_t hash = m_hasher(key);
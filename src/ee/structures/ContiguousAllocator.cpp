@@ -17,6 +17,8 @@
 
 #include "ContiguousAllocator.h"
 
+#include "common/MemoryPolicy.h"
+
 #include <cassert>
 
 using namespace voltdb;
@@ -32,11 +34,11 @@ ContiguousAllocator::ContiguousAllocator(int32_t allocSize, int32_t chunkSize)
 ContiguousAllocator::~ContiguousAllocator() {
     while (m_tail) {
         Buffer *buf = m_tail->prev;
-        free(m_tail);
+        MemoryPolicy::freeBlock(m_tail, bufferSize());
         m_tail = buf;
     }
     if (m_cachedBuffer != NULL) {
-        free(m_cachedBuffer);
+        MemoryPolicy::freeBlock(m_cachedBuffer, bufferSize());
     }
 }
 
@@ -53,7 +55,7 @@ void *ContiguousAllocator::alloc() {
             memory = static_cast<void *>(m_cachedBuffer);
             m_cachedBuffer = NULL;
         } else {
-            memory = static_cast<void *>(malloc(sizeof(Buffer) + m_allocationSize * m_numberAllocationsPerBlock));
+            memory = MemoryPolicy::allocateBlock(bufferSize());
         }
 
         Buffer *buf = reinterpret_cast<Buffer*>(memory);
@@ -100,7 +102,7 @@ void ContiguousAllocator::trim() {
         if (m_blockCount == 0) {
             m_cachedBuffer = m_tail;
         } else {
-            free(m_tail);
+            MemoryPolicy::freeBlock(m_tail, bufferSize());
         }
         m_tail = buf;
     }
@@ -73,6 +73,10 @@ class ContiguousAllocator {
      */
     Buffer *m_cachedBuffer;
 
+    size_t bufferSize() const {
+        return sizeof(Buffer) + static_cast<size_t>(m_allocationSize) * m_numberAllocationsPerBlock;
+    }
+
 public:
 
     /**
@@ -0,0 +1,118 @@
+/* This file is part of VoltDB.
+ * Copyright (C) 2008-2016 VoltDB Inc.
+ *
+ * This file contains original code and/or modifications of original code.
+ * Any modifications made by VoltDB Inc. are licensed under the following
+ * terms and conditions:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "harness.h"
+
+#include "common/MemoryPolicy.h"
+
+#include <cstring>
+#include <stdint.h>
+
+using namespace voltdb;
+
+class MemoryPolicyTest : public Test {
+public:
+    MemoryPolicyTest()
+      : m_hugePages(MemoryPolicy::hugePages()), m_localNode(MemoryPolicy::localNode())
+    {
+    }
+
+    ~MemoryPolicyTest()
+    {
+        MemoryPolicy::configure(m_hugePages, m_localNode);
+    }
+
+    // Fill a block end to end, so that every page of it is faulted in,
+    // and read it back.
+    void fillAndCheck(std::size_t size)
+    {
+        char* block = static_cast<char*>(MemoryPolicy::allocateBlock(size));
+        ASSERT_TRUE(block != NULL);
+        ::memset(block, 0x5a, size);
+        EXPECT_EQ(0x5a, block[0]);
+        EXPECT_EQ(0x5a, block[size - 1]);
+        if (MemoryPolicy::hugePages() != MemoryPolicy::HUGE_PAGES_NONE &&
+            MemoryPolicy::mappedSize(size) % MemoryPolicy::HUGE_PAGE_SIZE == 0) {
+            EXPECT_EQ(0, reinterpret_cast<uintptr_t>(block) % MemoryPolicy::HUGE_PAGE_SIZE);
+        }
+        MemoryPolicy::freeBlock(block, size);
+    }
+
+    void fillAndCheckSizes()
+    {
+        fillAndCheck(100);
+        fillAndCheck(262144);
+        fillAndCheck(MemoryPolicy::HUGE_PAGE_SIZE - 1000);
+        fillAndCheck(MemoryPolicy::HUGE_PAGE_SIZE);
+        fillAndCheck(3 * MemoryPolicy::HUGE_PAGE_SIZE + 4096);
+    }
+
+private:
+    const MemoryPolicy::HugePages m_hugePages;
+    const bool m_localNode;
+};
+
+TEST_F(MemoryPolicyTest, MappedSizes) {
+    EXPECT_EQ(MemoryPolicy::HUGE_PAGE_SIZE, MemoryPolicy::mappedSize(MemoryPolicy::HUGE_PAGE_SIZE));
+    // Within an eighth of a huge page, blocks are rounded up to a whole one.
+    EXPECT_EQ(MemoryPolicy::HUGE_PAGE_SIZE,
+              MemoryPolicy::mappedSize(MemoryPolicy::HUGE_PAGE_SIZE - MemoryPolicy::HUGE_PAGE_SIZE / 8));
+    EXPECT_EQ(2 * MemoryPolicy::HUGE_PAGE_SIZE,
+              MemoryPolicy::mappedSize(2 * MemoryPolicy::HUGE_PAGE_SIZE - 4096));
+    // Others only take whole pages.
+    std::size_t small = MemoryPolicy::mappedSize(262144 + 1);
+    EXPECT_TRUE(small > 262144 && small < 262144 + 65536);
+    std::size_t large = MemoryPolicy::mappedSize(MemoryPolicy::HUGE_PAGE_SIZE + 1);
+    EXPECT_TRUE(large > MemoryPolicy::HUGE_PAGE_SIZE && large < MemoryPolicy::HUGE_PAGE_SIZE + 65536);
+}
+
+TEST_F(MemoryPolicyTest, NoHugePages) {
+    MemoryPolicy::configure(MemoryPolicy::HUGE_PAGES_NONE, false);
+    fillAndCheckSizes();
+}
+
+TEST_F(MemoryPolicyTest, TransparentHugePages) {
+    MemoryPolicy::configure(MemoryPolicy::HUGE_PAGES_TRANSPARENT, false);
+    fillAndCheckSizes();
+}
+
+// Without reserved huge pages, these fall back to transparent ones.
+TEST_F(MemoryPolicyTest, ExplicitHugePages) {
+    MemoryPolicy::configure(MemoryPolicy::HUGE_PAGES_EXPLICIT, false);
+    fillAndCheckSizes();
+}
+
+TEST_F(MemoryPolicyTest, LocalNode) {
+    MemoryPolicy::configure(MemoryPolicy::HUGE_PAGES_TRANSPARENT, true);
+    fillAndCheckSizes();
+    MemoryPolicy::configure(MemoryPolicy::HUGE_PAGES_NONE, true);
+    fillAndCheckSizes();
+}
+
+int main() {
+    return TestSuite::globalInstance()->runAll();
+}
@@ -50,13 +50,20 @@
  */
 
 #include "harness.h"
+#include "common/Pool.hpp"
+#include "common/StringRef.h"
+#include "common/ThreadLocalPool.h"
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <set>
+#include <vector>
 
 using namespace std;
 
 namespace voltdb {
 int TestOnlyAllocationSizeForObject(int input);
+int TestOnlySizeClassForObject(int input);
 };
 
 // CHEATING SLIGHTLY -- The tests are a little too stringent when applied
@@ -159,6 +166,112 @@ TEST_F(ThreadLocalPoolTest, AllocationSizingRandom)
     }
 }
 
+TEST_F(ThreadLocalPoolTest, SizeClasses)
+{
+    for (int size = 1; size <= (1<<20); size++) {
+        int classSize = voltdb::TestOnlySizeClassForObject(size);
+        ASSERT_TRUE(classSize >= size);
+        ASSERT_EQ(0, classSize % 8);
+        // Waste is bounded to a third of the object beyond the small classes
+        ASSERT_TRUE(size <= 64 ? classSize - size < 8 : (classSize - size) * 3 < classSize);
+    }
+    EXPECT_EQ(8, voltdb::TestOnlySizeClassForObject(1));
+    EXPECT_EQ(64, voltdb::TestOnlySizeClassForObject(64));
+    EXPECT_EQ(96, voltdb::TestOnlySizeClassForObject(65));
+    EXPECT_EQ(128, voltdb::TestOnlySizeClassForObject(97));
+    EXPECT_EQ(192, voltdb::TestOnlySizeClassForObject(129));
+    EXPECT_EQ(3<<19, voltdb::TestOnlySizeClassForObject((1<<20) + 1));
+}
+
+TEST_F(ThreadLocalPoolTest, ExactSizedObjects)
+{
+    voltdb::ThreadLocalPool pool;
+    std::size_t baseline = voltdb::ThreadLocalPool::getPoolAllocationSize();
+    std::vector<void*> objects;
+    std::set<void*> distinct;
+    for (int i = 0; i < 100000; i++) {
+        void* object = voltdb::ThreadLocalPool::allocateExactSizedObject(40);
+        ::memset(object, i, 40);
+        objects.push_back(object);
+        distinct.insert(object);
+    }
+    ASSERT_EQ(objects.size(), distinct.size());
+    // 40 and 35 share a size class
+    void* other = voltdb::ThreadLocalPool::allocateExactSizedObject(35);
+    ASSERT_TRUE(distinct.find(other) == distinct.end());
+
+    std::vector<voltdb::ThreadLocalPool::SizeClassStats> stats;
+    voltdb::ThreadLocalPool::getExactSizedPoolStats(stats);
+    ASSERT_EQ(1, stats.size());
+    EXPECT_EQ(40, stats[0].m_objectSize);
+    EXPECT_EQ(100001, stats[0].m_liveObjects);
+    EXPECT_TRUE(stats[0].m_slabBytes >= 100001 * 40);
+    EXPECT_EQ(stats[0].m_slabBytes, voltdb::ThreadLocalPool::getPoolAllocationSize() - baseline);
+
+    // Freed objects are reused before the pool grows
+    std::size_t slabBytes = stats[0].m_slabBytes;
+    for (int i = 0; i < 50000; i++) {
+        voltdb::ThreadLocalPool::freeExactSizedObject(40, objects[i]);
+    }
+    for (int i = 0; i < 50000; i++) {
+        void* object = voltdb::ThreadLocalPool::allocateExactSizedObject(40);
+        ASSERT_TRUE(distinct.find(object) != distinct.end());
+        objects[i] = object;
+    }
+    voltdb::ThreadLocalPool::getExactSizedPoolStats(stats);
+    EXPECT_EQ(100001, stats[0].m_liveObjects);
+    EXPECT_EQ(slabBytes, stats[0].m_slabBytes);
+
+    for (int i = 0; i < objects.size(); i++) {
+        voltdb::ThreadLocalPool::freeExactSizedObject(40, objects[i]);
+    }
+    voltdb::ThreadLocalPool::freeExactSizedObject(35, other);
+    voltdb::ThreadLocalPool::getExactSizedPoolStats(stats);
+    EXPECT_EQ(0, stats[0].m_liveObjects);
+}
+
+TEST_F(ThreadLocalPoolTest, ShortStringsShareTheirStringRefAllocation)
+{
+    voltdb::ThreadLocalPool pool;
+    std::vector<voltdb::ThreadLocalPool::SizeClassStats> stats;
+    const char text[] = "a short string value";
+    const int32_t shortLength = static_cast<int32_t>(sizeof(text) - 1);
+
+    // The StringRef, size prefix and string take one 32 byte slot.
+    voltdb::StringRef* shortString = voltdb::StringRef::create(shortLength, text, NULL);
+    int32_t length;
+    const char* bytes = shortString->getObject(&length);
+    ASSERT_EQ(shortLength, length);
+    EXPECT_EQ(0, ::memcmp(text, bytes, shortLength));
+    EXPECT_EQ(32, shortString->getAllocatedSize());
+    voltdb::ThreadLocalPool::getExactSizedPoolStats(stats);
+    ASSERT_EQ(1, stats.size());
+    EXPECT_EQ(32, stats[0].m_objectSize);
+    EXPECT_EQ(1, stats[0].m_liveObjects);
+
+    // A longer one is kept in relocatable storage, referred to by a StringRef.
+    std::string longText(200, 'x');
+    voltdb::StringRef* longString = voltdb::StringRef::create(200, longText.c_str(), NULL);
+    EXPECT_EQ(200, longString->getObjectLength());
+    EXPECT_EQ(0, ::memcmp(longText.c_str(), longString->getObjectValue(), 200));
+    EXPECT_TRUE(longString->getAllocatedSize() > 200);
+    voltdb::ThreadLocalPool::getExactSizedPoolStats(stats);
+    EXPECT_EQ(2, stats.size());
+
+    // Temporary strings are left to their pool.
+    voltdb::Pool tempPool;
+    voltdb::StringRef* tempString = voltdb::StringRef::create(shortLength, text, &tempPool);
+    EXPECT_EQ(shortLength, tempString->getObjectLength());
+    voltdb::StringRef::destroy(tempString);
+
+    voltdb::StringRef::destroy(shortString);
+    voltdb::StringRef::destroy(longString);
+    voltdb::ThreadLocalPool::getExactSizedPoolStats(stats);
+    for (int i = 0; i < stats.size(); i++) {
+        EXPECT_EQ(0, stats[i].m_liveObjects);
+    }
+}
+
 int main() {
     return TestSuite::globalInstance()->runAll();
 }
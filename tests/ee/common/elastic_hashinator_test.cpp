@@ -24,8 +24,11 @@
 #include "common/serializeio.h"
 #include "common/ElasticHashinator.h"
 
+#include <algorithm>
 #include <cfloat>
+#include <cstdlib>
 #include <limits>
+#include <vector>
 
 using namespace std;
 using namespace voltdb;
@@ -112,6 +115,64 @@ TEST_F(ElasticHashinatorTest, TestNValueHashToken)
     }
 }
 
+// Tokens spread over the ring, with a tight cluster that lands many
+// token boundaries in the same slice of the lookup table.
+TEST_F(ElasticHashinatorTest, TestLookupMatchesRingSearch)
+{
+    std::vector<int32_t> ringTokens;
+    ringTokens.push_back(std::numeric_limits<int32_t>::min());
+    for (int i = 1; i < 200; i++) {
+        ringTokens.push_back(std::numeric_limits<int32_t>::min() + i * 10737418);
+    }
+    for (int i = 0; i < 50; i++) {
+        ringTokens.push_back(1000 + i * 3);
+    }
+    ringTokens.push_back(std::numeric_limits<int32_t>::max());
+    std::sort(ringTokens.begin(), ringTokens.end());
+
+    std::vector<int32_t> config;
+    for (size_t i = 0; i < ringTokens.size(); i++) {
+        config.push_back(ringTokens[i]);
+        config.push_back(static_cast<int32_t>(i % 7));
+    }
+    boost::scoped_ptr<TheHashinator> hashinator(
+        ElasticHashinator::newInstance(NULL, &config[0], static_cast<uint32_t>(ringTokens.size())));
+
+    std::vector<int32_t> hashes;
+    for (size_t i = 0; i < ringTokens.size(); i++) {
+        hashes.push_back(ringTokens[i]);
+        if (ringTokens[i] != std::numeric_limits<int32_t>::min()) {
+            hashes.push_back(ringTokens[i] - 1);
+        }
+        if (ringTokens[i] != std::numeric_limits<int32_t>::max()) {
+            hashes.push_back(ringTokens[i] + 1);
+        }
+    }
+    srand(42);
+    for (int i = 0; i < 100000; i++) {
+        hashes.push_back(static_cast<int32_t>((static_cast<uint32_t>(rand()) << 16) ^ rand()));
+    }
+
+    for (size_t i = 0; i < hashes.size(); i++) {
+        size_t expected = 0;
+        while (expected + 1 < ringTokens.size() && ringTokens[expected + 1] <= hashes[i]) {
+            expected++;
+        }
+        ASSERT_EQ(static_cast<int32_t>(expected % 7), hashinator->partitionForToken(hashes[i]));
+    }
+
+    std::vector<NValue> values;
+    for (int i = -1000; i < 1000; i++) {
+        values.push_back(ValueFactory::getBigIntValue(i));
+    }
+    values.push_back(NValue::getNullValue(VALUE_TYPE_INTEGER));
+    std::vector<int32_t> partitions(values.size());
+    hashinator->hashinateAll(&values[0], values.size(), &partitions[0]);
+    for (size_t i = 0; i < values.size(); i++) {
+        EXPECT_EQ(hashinator->hashinate(values[i]), partitions[i]);
+    }
+}
+
 int main() {
     return TestSuite::globalInstance()->runAll();
 }
@@ -0,0 +1,129 @@
+/* This file is part of VoltDB.
+ * Copyright (C) 2008-2016 VoltDB Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "harness.h"
+#include "common/LZ4Codec.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace std;
+using namespace voltdb;
+
+class LZ4CodecTest : public Test {
+public:
+    LZ4CodecTest() {
+        srand(0);
+    }
+
+    // Runs copied from recent bytes with a few random ones mixed in,
+    // like the rows of a DR buffer
+    vector<char> repetitiveInput(size_t length) {
+        vector<char> input(length);
+        size_t i = 0;
+        while (i < length) {
+            if (i > 256 && rand() % 4 != 0) {
+                size_t from = i - 1 - rand() % 256;
+                size_t run = 8 + rand() % 32;
+                for (size_t j = 0; j < run && i < length; j++) {
+                    input[i++] = input[from + j];
+                }
+            }
+            else {
+                input[i++] = static_cast<char>('a' + rand() % 26);
+            }
+        }
+        return input;
+    }
+
+    bool roundTrip(const vector<char> &input, size_t *compressedLength = NULL) {
+        vector<char> compressed(LZ4Codec::maxCompressedLength(input.size()));
+        size_t length = LZ4Codec::compress(input.empty() ? NULL : &input[0], input.size(),
+                                           &compressed[0], compressed.size());
+        if (compressedLength != NULL) {
+            *compressedLength = length;
+        }
+        if (length == 0) {
+            return false;
+        }
+        vector<char> output(input.size() + 1);
+        if ( ! LZ4Codec::decompress(&compressed[0], length, &output[0], input.size())) {
+            return false;
+        }
+        return input.empty() || ::memcmp(&input[0], &output[0], input.size()) == 0;
+    }
+};
+
+TEST_F(LZ4CodecTest, RoundTripSmallInputs) {
+    for (size_t length = 0; length < 64; length++) {
+        EXPECT_TRUE(roundTrip(repetitiveInput(length)));
+    }
+}
+
+TEST_F(LZ4CodecTest, RoundTripShrinksRepetitiveInput) {
+    vector<char> input = repetitiveInput(1024 * 1024);
+    size_t compressedLength = 0;
+    EXPECT_TRUE(roundTrip(input, &compressedLength));
+    EXPECT_TRUE(compressedLength < input.size() / 2);
+}
+
+TEST_F(LZ4CodecTest, RoundTripLongRuns) {
+    // match and literal lengths that need extra length bytes
+    vector<char> input(100000, 'x');
+    for (size_t i = 50000; i < 51000; i++) {
+        input[i] = static_cast<char>(rand());
+    }
+    EXPECT_TRUE(roundTrip(input));
+}
+
+TEST_F(LZ4CodecTest, CompressReportsOverflow) {
+    vector<char> input(4096);
+    for (size_t i = 0; i < input.size(); i++) {
+        input[i] = static_cast<char>(rand());
+    }
+    vector<char> compressed(LZ4Codec::maxCompressedLength(input.size()));
+    // random bytes do not compress, so a buffer smaller than the input is too small
+    EXPECT_EQ(0u, LZ4Codec::compress(&input[0], input.size(), &compressed[0], input.size() - 1));
+    EXPECT_TRUE(roundTrip(input));
+}
+
+TEST_F(LZ4CodecTest, DecompressRejectsCorruptInput) {
+    vector<char> input = repetitiveInput(10000);
+    vector<char> compressed(LZ4Codec::maxCompressedLength(input.size()));
+    size_t length = LZ4Codec::compress(&input[0], input.size(), &compressed[0], compressed.size());
+    ASSERT_TRUE(length > 0);
+    vector<char> output(input.size());
+
+    // wrong expected length
+    EXPECT_FALSE(LZ4Codec::decompress(&compressed[0], length, &output[0], input.size() - 1));
+    // truncated input
+    EXPECT_FALSE(LZ4Codec::decompress(&compressed[0], length / 2, &output[0], input.size()));
+    // an offset reaching back before the start of the output
+    const char badOffset[] = { 0x10, 'a', 0x10, 0x00, 0x50, 'a', 'a', 'a', 'a', 'a' };
+    EXPECT_FALSE(LZ4Codec::decompress(badOffset, sizeof(badOffset), &output[0], 14));
+}
+
+int main() {
+    return TestSuite::globalInstance()->runAll();
+}
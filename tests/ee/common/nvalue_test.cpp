@@ -2672,6 +2672,50 @@ TEST_F(NValueTest, TestInList)
     }
 }
 
+TEST_F(NValueTest, TestLongInList)
+{
+    assert(ExecutorContext::getExecutorContext() == NULL);
+    Pool* testPool = new Pool();
+    getExecutorContextForTest(testPool);
+
+    // Long enough to be searched through its sorted copy,
+    // unordered and with duplicates.
+    const size_t int_length = 150;
+    NValue int_NV_set[int_length];
+    for (size_t ii = 0; ii < int_length; ++ii) {
+        int_NV_set[ii] = ValueFactory::getIntegerValue(static_cast<int32_t>((ii * 37) % 100) * 3);
+    }
+    NValue int_list =
+        streamNValueArrayintoInList(VALUE_TYPE_INTEGER, int_NV_set, int_length, testPool);
+    for (int32_t value = -10; value < 310; ++value) {
+        bool expected = (value >= 0) && (value % 3 == 0) && (value < 300);
+        EXPECT_EQ(expected, ValueFactory::getIntegerValue(value).inList(int_list));
+        EXPECT_EQ(expected, ValueFactory::getBigIntValue(value).inList(int_list));
+    }
+    EXPECT_FALSE(NValue::getNullValue(VALUE_TYPE_INTEGER).inList(int_list));
+
+    const char* string_set[] = { "pear", "apple", "fig", "plum", "kiwi", "lime", "date", "sloe",
+                                 "apple", "quince", "lemon", "melon", "grape", "peach", "mango",
+                                 "guava", "olive", "fig" };
+    const size_t string_length = SIZE_OF_ARRAY(string_set);
+    NValue string_NV_set[string_length];
+    initNValueArray(string_NV_set, string_set, string_length);
+    NValue string_list =
+        streamNValueArrayintoInList(VALUE_TYPE_VARCHAR, string_NV_set, string_length, testPool);
+    for (size_t ii = 0; ii < string_length; ++ii) {
+        EXPECT_TRUE(string_NV_set[ii].inList(string_list));
+    }
+    const char* missing_set[] = { "", "aardvark", "figs", "peaches", "zucchini" };
+    const size_t missing_length = SIZE_OF_ARRAY(missing_set);
+    NValue missing_NV_set[missing_length];
+    initNValueArray(missing_NV_set, missing_set, missing_length);
+    for (size_t ii = 0; ii < missing_length; ++ii) {
+        EXPECT_FALSE(missing_NV_set[ii].inList(string_list));
+    }
+    freeNValueArray(string_NV_set, string_length);
+    freeNValueArray(missing_NV_set, missing_length);
+}
+
 bool checkValueVector(vector<NValue> &values) {
     // check the array by verifying all values are larger than the previous value
     // this checks order and the lack of duplicates
@@ -0,0 +1,167 @@
+/* This file is part of VoltDB.
+ * Copyright (C) 2008-2016 VoltDB Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "harness.h"
+
+#include "common/subquerycontext.h"
+#include "common/tabletuple.h"
+#include "common/TupleSchema.h"
+#include "common/ValueFactory.hpp"
+#include "common/ValuePeeker.hpp"
+#include "storage/tablefactory.h"
+#include "storage/tableiterator.h"
+#include "storage/temptable.h"
+#include "storage/TempTableLimits.h"
+
+#include <boost/scoped_ptr.hpp>
+#include <sstream>
+
+using namespace voltdb;
+
+class SubqueryResultCacheTest : public Test
+{
+public:
+    SubqueryResultCacheTest() : m_limits(1024 * 1024 * 100)
+    {
+        std::vector<ValueType> columnTypes;
+        columnTypes.push_back(VALUE_TYPE_INTEGER);
+        columnTypes.push_back(VALUE_TYPE_VARCHAR);
+        std::vector<int32_t> columnLengths;
+        columnLengths.push_back(NValue::getTupleStorageSize(VALUE_TYPE_INTEGER));
+        columnLengths.push_back(100);
+        std::vector<bool> allowNull(2, true);
+        std::vector<std::string> columnNames;
+        columnNames.push_back("ID");
+        columnNames.push_back("NAME");
+        TupleSchema* schema = TupleSchema::createTupleSchemaForTest(columnTypes, columnLengths, allowNull);
+        m_table.reset(TableFactory::buildTempTable("OUTPUT", schema, columnNames, &m_limits));
+    }
+
+    // Replace the contents of the output table with rows (i, "name<i>") for i in [first, first + count).
+    void fillTable(int first, int count)
+    {
+        m_table->deleteAllTempTuples();
+        TableTuple& tuple = m_table->tempTuple();
+        for (int i = first; i < first + count; ++i) {
+            std::ostringstream name;
+            name << "name" << i;
+            tuple.setNValue(0, ValueFactory::getIntegerValue(i));
+            tuple.setNValue(1, ValueFactory::getStringValue(name.str(), &m_stringPool));
+            m_table->insertTempTuple(tuple);
+        }
+    }
+
+    // Check that the output table holds exactly the rows fillTable(first, count) produces.
+    void checkTable(int first, int count)
+    {
+        ASSERT_EQ(count, m_table->activeTupleCount());
+        TableIterator iterator = m_table->iterator();
+        TableTuple tuple(m_table->schema());
+        int i = first;
+        while (iterator.next(tuple)) {
+            std::ostringstream name;
+            name << "name" << i;
+            EXPECT_EQ(i, ValuePeeker::peekInteger(tuple.getNValue(0)));
+            NValue expected = ValueFactory::getStringValue(name.str(), &m_stringPool);
+            EXPECT_EQ(0, tuple.getNValue(1).compare(expected));
+            ++i;
+        }
+    }
+
+    static std::vector<NValue> key(int a, int b)
+    {
+        std::vector<NValue> params;
+        params.push_back(ValueFactory::getIntegerValue(a));
+        params.push_back(ValueFactory::getBigIntValue(b));
+        return params;
+    }
+
+protected:
+    TempTableLimits m_limits;
+    Pool m_stringPool;
+    boost::scoped_ptr<TempTable> m_table;
+};
+
+TEST_F(SubqueryResultCacheTest, StoreAndLoad)
+{
+    int64_t allocatedBefore;
+    {
+        fillTable(0, 1);
+        allocatedBefore = m_limits.getAllocated();
+        SubqueryResultCache cache(&m_limits);
+
+        cache.storeResult(key(1, 1), m_table.get());
+        fillTable(10, 5);
+        cache.storeResult(key(1, 2), m_table.get());
+        // An empty result is worth remembering too.
+        fillTable(0, 0);
+        cache.storeResult(key(2, 1), m_table.get());
+        EXPECT_TRUE(m_limits.getAllocated() > allocatedBefore);
+
+        // The cached copies do not depend on the strings they were made from.
+        m_stringPool.purge();
+
+        m_table->deleteAllTempTuples();
+        EXPECT_FALSE(cache.loadResult(key(2, 2), m_table.get()));
+        EXPECT_EQ(0, m_table->activeTupleCount());
+
+        EXPECT_TRUE(cache.loadResult(key(1, 2), m_table.get()));
+        checkTable(10, 5);
+
+        m_table->deleteAllTempTuples();
+        EXPECT_TRUE(cache.loadResult(key(1, 1), m_table.get()));
+        checkTable(0, 1);
+
+        m_table->deleteAllTempTuples();
+        EXPECT_TRUE(cache.loadResult(key(2, 1), m_table.get()));
+        EXPECT_EQ(0, m_table->activeTupleCount());
+    }
+    // The cache hands back its memory when it goes away.
+    EXPECT_EQ(allocatedBefore, m_limits.getAllocated());
+}
+
+TEST_F(SubqueryResultCacheTest, BoundedByTempTableLimits)
+{
+    // Leaves the cache a 32K budget.
+    TempTableLimits cacheLimits(64 * 1024);
+    SubqueryResultCache cache(&cacheLimits);
+
+    fillTable(0, 10);
+    cache.storeResult(key(1, 1), m_table.get());
+    fillTable(0, 500);
+    cache.storeResult(key(1, 2), m_table.get());
+    // Once a result has not fit, nothing more is cached.
+    fillTable(0, 1);
+    cache.storeResult(key(1, 3), m_table.get());
+    EXPECT_TRUE(cacheLimits.getAllocated() <= 32 * 1024);
+
+    m_table->deleteAllTempTuples();
+    EXPECT_TRUE(cache.loadResult(key(1, 1), m_table.get()));
+    checkTable(0, 10);
+    EXPECT_FALSE(cache.loadResult(key(1, 2), m_table.get()));
+    EXPECT_FALSE(cache.loadResult(key(1, 3), m_table.get()));
+}
+
+int main() {
+    return TestSuite::globalInstance()->runAll();
+}
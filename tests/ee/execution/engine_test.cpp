@@ -586,6 +586,197 @@ TEST_F(ExecutionEngineTest, Execute_PlanFragmentInfo) {
     }
 }
 
+/*
+ * A plan that has been used more than once should stay cached while
+ * a long run of plans that are each used only once goes through.
+ */
+TEST_F(ExecutionEngineTest, ReusedPlansSurviveOneOffPlans) {
+    initialize(catalog_string, random_seed);
+    memset(m_parameter_buffer.get(), 0, 4 * 1024);
+
+    fragmentId_t reusedId = 100;
+    m_topend->addPlan(reusedId, plan);
+    for (int ii = 0; ii < 2; ++ii) {
+        voltdb::ReferenceSerializeInputBE emptyParams(m_parameter_buffer.get(), 4 * 1024);
+        ASSERT_EQ(0, m_engine->executePlanFragments(1, &reusedId, NULL, emptyParams,
+                                                    1000, 1000, 1000, 1000, 1));
+    }
+    ASSERT_EQ(1, m_topend->planFetchCount());
+
+    // More one-off plans than the whole cache holds.
+    const int oneOffCount = 1100;
+    for (fragmentId_t oneOffId = 1000; oneOffId < 1000 + oneOffCount; ++oneOffId) {
+        m_topend->addPlan(oneOffId, plan);
+        voltdb::ReferenceSerializeInputBE emptyParams(m_parameter_buffer.get(), 4 * 1024);
+        ASSERT_EQ(0, m_engine->executePlanFragments(1, &oneOffId, NULL, emptyParams,
+                                                    1000, 1000, 1000, 1000, 1));
+    }
+    ASSERT_EQ(1 + oneOffCount, m_topend->planFetchCount());
+
+    voltdb::ReferenceSerializeInputBE emptyParams(m_parameter_buffer.get(), 4 * 1024);
+    ASSERT_EQ(0, m_engine->executePlanFragments(1, &reusedId, NULL, emptyParams,
+                                                1000, 1000, 1000, 1000, 1));
+    EXPECT_EQ(1 + oneOffCount, m_topend->planFetchCount());
+}
+
+/*
+ * With executor profiling on, a fragment returns one more table after its
+ * results: a row for each executor, followed by rows for its inline nodes.
+ */
+TEST_F(ExecutionEngineTest, ExecutorProfileFollowsResults) {
+    initialize(catalog_string, random_seed);
+    memset(m_parameter_buffer.get(), 0, 4 * 1024);
+    fragmentId_t fragmentId = 100;
+    m_topend->addPlan(fragmentId, plan);
+
+    m_engine->setExecutorProfiling(true);
+    voltdb::ReferenceSerializeInputBE emptyParams(m_parameter_buffer.get(), 4 * 1024);
+    ASSERT_EQ(0, m_engine->executePlanFragments(1, &fragmentId, NULL, emptyParams,
+                                                1000, 1000, 1000, 1000, 1));
+
+    voltdb::ReferenceSerializeInputBE results(m_result_buffer.get(), m_engine->getResultsSize());
+    results.readInt();  // message length
+    results.readByte(); // dirty flag
+    ASSERT_EQ(2, results.readInt());
+    // Skip over the query's own result table.
+    results.readInt();
+    int32_t tableLength = results.readInt();
+    results.getRawPointer(tableLength);
+
+    results.readInt();
+    results.readInt();  // table length
+    results.readInt();  // metadata length
+    results.readByte(); // status
+    ASSERT_EQ(10, results.readShort());
+    for (int col = 0; col < 10; ++col) {
+        results.readByte();
+    }
+    std::vector<std::string> names;
+    for (int col = 0; col < 10; ++col) {
+        names.push_back(results.readTextString());
+    }
+    EXPECT_EQ("PLAN_NODE_TYPE", names[2]);
+    EXPECT_EQ("INDEX_PROBES", names[8]);
+
+    // The index scan runs first, then its inline projection, then the send.
+    ASSERT_EQ(3, results.readInt());
+    const int32_t expectedIds[] = { 2, 3, 1 };
+    const char* expectedTypes[] = { "INDEXSCAN", "PROJECTION", "SEND" };
+    int64_t scanTuplesOut = -1;
+    for (int row = 0; row < 3; ++row) {
+        results.readInt();  // row length
+        EXPECT_EQ(0, results.readInt());
+        EXPECT_EQ(expectedIds[row], results.readInt());
+        EXPECT_EQ(std::string(expectedTypes[row]), results.readTextString());
+        int32_t inlinedIn = results.readInt();
+        int64_t values[6];
+        for (int col = 0; col < 6; ++col) {
+            values[col] = results.readLong();
+        }
+        if (row == 1) {
+            EXPECT_EQ(2, inlinedIn);
+            EXPECT_EQ(INT64_NULL, values[0]);
+            continue;
+        }
+        EXPECT_EQ(INT32_NULL, inlinedIn);
+        EXPECT_TRUE(values[0] >= 0);
+        if (row == 0) {
+            // A leaf has no input, and probes its index once.
+            EXPECT_EQ(INT64_NULL, values[1]);
+            EXPECT_EQ(1, values[4]);
+            scanTuplesOut = values[2];
+        }
+        else {
+            EXPECT_EQ(scanTuplesOut, values[1]);
+            EXPECT_EQ(0, values[4]);
+        }
+    }
+
+    // Turned off, the fragment returns only its own results again.
+    m_engine->setExecutorProfiling(false);
+    m_engine->resetReusedResultOutputBuffer();
+    voltdb::ReferenceSerializeInputBE moreParams(m_parameter_buffer.get(), 4 * 1024);
+    ASSERT_EQ(0, m_engine->executePlanFragments(1, &fragmentId, NULL, moreParams,
+                                                1000, 1000, 1000, 1000, 1));
+    voltdb::ReferenceSerializeInputBE plainResults(m_result_buffer.get(), m_engine->getResultsSize());
+    plainResults.readInt();
+    plainResults.readByte();
+    EXPECT_EQ(1, plainResults.readInt());
+}
+
+namespace {
+/*
+ * UPSERT INTO R_CUSTOMER SELECT CID, LAST, FIRST, CID FROM <source>,
+ * which swaps the names around and sets the zip code to the id.
+ */
+std::string upsertPlan(const std::string &source) {
+    std::string tve = "{\"TYPE\": 32, \"COLUMN_IDX\": ";
+    return
+        "{\n"
+        "    \"EXECUTE_LIST\": [3, 2, 1],\n"
+        "    \"PLAN_NODES\": [\n"
+        "        {\"ID\": 1, \"PLAN_NODE_TYPE\": \"SEND\", \"CHILDREN_IDS\": [2]},\n"
+        "        {\"ID\": 2, \"PLAN_NODE_TYPE\": \"INSERT\", \"CHILDREN_IDS\": [3],\n"
+        "         \"TARGET_TABLE_NAME\": \"R_CUSTOMER\", \"MULTI_PARTITION\": false,\n"
+        "         \"FIELD_MAP\": [0, 1, 2, 3], \"UPSERT\": true},\n"
+        "        {\"ID\": 3, \"PLAN_NODE_TYPE\": \"SEQSCAN\",\n"
+        "         \"TARGET_TABLE_NAME\": \"" + source + "\", \"TARGET_TABLE_ALIAS\": \"" + source + "\",\n"
+        "         \"INLINE_NODES\": [{\"ID\": 4, \"PLAN_NODE_TYPE\": \"PROJECTION\", \"OUTPUT_SCHEMA\": [\n"
+        "             {\"COLUMN_NAME\": \"CID\", \"EXPRESSION\": " + tve + "0, \"VALUE_TYPE\": 5}},\n"
+        "             {\"COLUMN_NAME\": \"LAST\", \"EXPRESSION\": " + tve + "2, \"VALUE_TYPE\": 9, \"VALUE_SIZE\": 2048}},\n"
+        "             {\"COLUMN_NAME\": \"FIRST\", \"EXPRESSION\": " + tve + "1, \"VALUE_TYPE\": 9, \"VALUE_SIZE\": 2048}},\n"
+        "             {\"COLUMN_NAME\": \"ZIP\", \"EXPRESSION\": " + tve + "0, \"VALUE_TYPE\": 5}}\n"
+        "         ]}]}\n"
+        "    ]\n"
+        "}\n";
+}
+}
+
+/*
+ * A multi-row upsert inserts the rows it does not find and updates the
+ * ones it does, whatever order it applies them in.
+ */
+TEST_F(ExecutionEngineTest, MultiRowUpsert) {
+    initialize(catalog_string, random_seed);
+    memset(m_parameter_buffer.get(), 0, 4 * 1024);
+    fragmentId_t fragmentId = 100;
+    m_topend->addPlan(fragmentId, upsertPlan("D_CUSTOMER"));
+
+    voltdb::PersistentTable *target = dynamic_cast<voltdb::PersistentTable*>(m_replicated_customer_table);
+    ASSERT_TRUE(target != NULL);
+    int64_t targetCount = target->activeTupleCount();
+    int64_t newCount = 0;
+    voltdb::TableTuple sourceTuple(m_partitioned_customer_table->schema());
+    voltdb::TableIterator sourceRows = m_partitioned_customer_table->iterator();
+    while (sourceRows.next(sourceTuple)) {
+        voltdb::TableTuple &probe = target->tempTuple();
+        probe.setNValue(0, sourceTuple.getNValue(0));
+        if (target->primaryKeyIndex()->uniqueMatchingTuple(probe).isNullTuple()) {
+            ++newCount;
+        }
+    }
+
+    // The first run mostly inserts, the second one only updates.
+    for (int run = 0; run < 2; ++run) {
+        voltdb::ReferenceSerializeInputBE emptyParams(m_parameter_buffer.get(), 4 * 1024);
+        ASSERT_EQ(0, m_engine->executePlanFragments(1, &fragmentId, NULL, emptyParams,
+                                                    1000, 1000, 1000, 1000, 1));
+        m_engine->resetReusedResultOutputBuffer();
+        ASSERT_EQ(targetCount + newCount, target->activeTupleCount());
+
+        sourceRows = m_partitioned_customer_table->iterator();
+        while (sourceRows.next(sourceTuple)) {
+            voltdb::TableTuple &probe = target->tempTuple();
+            probe.setNValue(0, sourceTuple.getNValue(0));
+            voltdb::TableTuple row = target->primaryKeyIndex()->uniqueMatchingTuple(probe);
+            ASSERT_FALSE(row.isNullTuple());
+            EXPECT_EQ(0, row.getNValue(1).compare(sourceTuple.getNValue(2)));
+            EXPECT_EQ(0, row.getNValue(2).compare(sourceTuple.getNValue(1)));
+            EXPECT_EQ(0, row.getNValue(3).compare(sourceTuple.getNValue(0)));
+        }
+    }
+}
+
 int main() {
      return TestSuite::globalInstance()->runAll();
 }
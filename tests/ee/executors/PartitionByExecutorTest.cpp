@@ -473,6 +473,542 @@ const char *plan_strings[] = {
     "        }\n"
     "    ]\n"
     "}\n",
+    //  Plan for this query:
+    //      select SUM(C), MIN(C), MAX(C), COUNT(*) OVER ( PARTITION BY A ORDER BY B
+    //                 ROWS BETWEEN 1 PRECEDING AND 1 FOLLOWING ), A, B, C from AAA;
+    "{\n"
+    "    \"EXECUTE_LIST\": [\n"
+    "        1,\n"
+    "        2,\n"
+    "        3,\n"
+    "        4\n"
+    "    ],\n"
+    "    \"PLAN_NODES\": [\n"
+    "        {\n"
+    "            \"CHILDREN_IDS\": [\n"
+    "                3\n"
+    "            ],\n"
+    "            \"ID\": 4,\n"
+    "            \"PLAN_NODE_TYPE\": \"SEND\"\n"
+    "        },\n"
+    "        {\n"
+    "            \"AGGREGATE_COLUMNS\": [\n"
+    "                {\n"
+    "                    \"AGGREGATE_DISTINCT\": 0,\n"
+    "                    \"AGGREGATE_OUTPUT_COLUMN\": 0,\n"
+    "                    \"AGGREGATE_TYPE\": \"AGGREGATE_SUM\",\n"
+    "                    \"AGGREGATE_EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 2,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"AGGREGATE_DISTINCT\": 0,\n"
+    "                    \"AGGREGATE_OUTPUT_COLUMN\": 1,\n"
+    "                    \"AGGREGATE_TYPE\": \"AGGREGATE_MIN\",\n"
+    "                    \"AGGREGATE_EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 2,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"AGGREGATE_DISTINCT\": 0,\n"
+    "                    \"AGGREGATE_OUTPUT_COLUMN\": 2,\n"
+    "                    \"AGGREGATE_TYPE\": \"AGGREGATE_MAX\",\n"
+    "                    \"AGGREGATE_EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 2,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"AGGREGATE_DISTINCT\": 0,\n"
+    "                    \"AGGREGATE_OUTPUT_COLUMN\": 3,\n"
+    "                    \"AGGREGATE_TYPE\": \"AGGREGATE_COUNT_STAR\"\n"
+    "                }\n"
+    "            ],\n"
+    "            \"CHILDREN_IDS\": [\n"
+    "                2\n"
+    "            ],\n"
+    "            \"GROUPBY_EXPRESSIONS\": [\n"
+    "                {\n"
+    "                    \"COLUMN_IDX\": 0,\n"
+    "                    \"TYPE\": 32,\n"
+    "                    \"VALUE_TYPE\": 5\n"
+    "                }\n"
+    "            ],\n"
+    "            \"ID\": 3,\n"
+    "            \"OUTPUT_SCHEMA\": [\n"
+    "                {\n"
+    "                    \"COLUMN_NAME\": \"W0\",\n"
+    "                    \"EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 0,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"COLUMN_NAME\": \"W1\",\n"
+    "                    \"EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 1,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"COLUMN_NAME\": \"W2\",\n"
+    "                    \"EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 2,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"COLUMN_NAME\": \"W3\",\n"
+    "                    \"EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 3,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"COLUMN_NAME\": \"A\",\n"
+    "                    \"EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 0,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"COLUMN_NAME\": \"B\",\n"
+    "                    \"EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 1,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"COLUMN_NAME\": \"C\",\n"
+    "                    \"EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 2,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                }\n"
+    "            ],\n"
+    "            \"PLAN_NODE_TYPE\": \"PARTITIONBY\",\n"
+    "            \"SORT_COLUMNS\": [\n"
+    "                {\n"
+    "                    \"SORT_DIRECTION\": \"ASC\",\n"
+    "                    \"SORT_EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 1,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                }\n"
+    "            ],\n"
+    "            \"WINDOW_FRAME\": {\n"
+    "                \"FRAME_UNIT\": \"ROWS\",\n"
+    "                \"FRAME_START\": {\n"
+    "                    \"BOUND_TYPE\": \"PRECEDING\",\n"
+    "                    \"BOUND_OFFSET\": 1\n"
+    "                },\n"
+    "                \"FRAME_END\": {\n"
+    "                    \"BOUND_TYPE\": \"FOLLOWING\",\n"
+    "                    \"BOUND_OFFSET\": 1\n"
+    "                }\n"
+    "            }\n"
+    "        },\n"
+    "        {\n"
+    "            \"CHILDREN_IDS\": [\n"
+    "                1\n"
+    "            ],\n"
+    "            \"ID\": 2,\n"
+    "            \"PLAN_NODE_TYPE\": \"ORDERBY\",\n"
+    "            \"SORT_COLUMNS\": [\n"
+    "                {\n"
+    "                    \"SORT_DIRECTION\": \"ASC\",\n"
+    "                    \"SORT_EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 0,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"SORT_DIRECTION\": \"ASC\",\n"
+    "                    \"SORT_EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 1,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"SORT_DIRECTION\": \"ASC\",\n"
+    "                    \"SORT_EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 2,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                }\n"
+    "            ]\n"
+    "        },\n"
+    "        {\n"
+    "            \"ID\": 1,\n"
+    "            \"PLAN_NODE_TYPE\": \"SEQSCAN\",\n"
+    "            \"TARGET_TABLE_ALIAS\": \"AAA\",\n"
+    "            \"TARGET_TABLE_NAME\": \"AAA\"\n"
+    "        }\n"
+    "    ]\n"
+    "}\n",
+    //  Plan for this query, which has the default frame:
+    //      select SUM(C), COUNT(C), AVG(C), DENSE_RANK() OVER ( PARTITION BY A ORDER BY B ), A, B, C from AAA;
+    "{\n"
+    "    \"EXECUTE_LIST\": [\n"
+    "        1,\n"
+    "        2,\n"
+    "        3,\n"
+    "        4\n"
+    "    ],\n"
+    "    \"PLAN_NODES\": [\n"
+    "        {\n"
+    "            \"CHILDREN_IDS\": [\n"
+    "                3\n"
+    "            ],\n"
+    "            \"ID\": 4,\n"
+    "            \"PLAN_NODE_TYPE\": \"SEND\"\n"
+    "        },\n"
+    "        {\n"
+    "            \"AGGREGATE_COLUMNS\": [\n"
+    "                {\n"
+    "                    \"AGGREGATE_DISTINCT\": 0,\n"
+    "                    \"AGGREGATE_OUTPUT_COLUMN\": 0,\n"
+    "                    \"AGGREGATE_TYPE\": \"AGGREGATE_SUM\",\n"
+    "                    \"AGGREGATE_EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 2,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"AGGREGATE_DISTINCT\": 0,\n"
+    "                    \"AGGREGATE_OUTPUT_COLUMN\": 1,\n"
+    "                    \"AGGREGATE_TYPE\": \"AGGREGATE_COUNT\",\n"
+    "                    \"AGGREGATE_EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 2,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"AGGREGATE_DISTINCT\": 0,\n"
+    "                    \"AGGREGATE_OUTPUT_COLUMN\": 2,\n"
+    "                    \"AGGREGATE_TYPE\": \"AGGREGATE_AVG\",\n"
+    "                    \"AGGREGATE_EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 2,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"AGGREGATE_DISTINCT\": 0,\n"
+    "                    \"AGGREGATE_OUTPUT_COLUMN\": 3,\n"
+    "                    \"AGGREGATE_TYPE\": \"AGGREGATE_WINDOWED_DENSE_RANK\"\n"
+    "                }\n"
+    "            ],\n"
+    "            \"CHILDREN_IDS\": [\n"
+    "                2\n"
+    "            ],\n"
+    "            \"GROUPBY_EXPRESSIONS\": [\n"
+    "                {\n"
+    "                    \"COLUMN_IDX\": 0,\n"
+    "                    \"TYPE\": 32,\n"
+    "                    \"VALUE_TYPE\": 5\n"
+    "                }\n"
+    "            ],\n"
+    "            \"ID\": 3,\n"
+    "            \"OUTPUT_SCHEMA\": [\n"
+    "                {\n"
+    "                    \"COLUMN_NAME\": \"W0\",\n"
+    "                    \"EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 0,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"COLUMN_NAME\": \"W1\",\n"
+    "                    \"EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 1,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"COLUMN_NAME\": \"W2\",\n"
+    "                    \"EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 2,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"COLUMN_NAME\": \"W3\",\n"
+    "                    \"EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 3,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"COLUMN_NAME\": \"A\",\n"
+    "                    \"EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 0,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"COLUMN_NAME\": \"B\",\n"
+    "                    \"EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 1,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"COLUMN_NAME\": \"C\",\n"
+    "                    \"EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 2,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                }\n"
+    "            ],\n"
+    "            \"PLAN_NODE_TYPE\": \"PARTITIONBY\",\n"
+    "            \"SORT_COLUMNS\": [\n"
+    "                {\n"
+    "                    \"SORT_DIRECTION\": \"ASC\",\n"
+    "                    \"SORT_EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 1,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                }\n"
+    "            ]\n"
+    "        },\n"
+    "        {\n"
+    "            \"CHILDREN_IDS\": [\n"
+    "                1\n"
+    "            ],\n"
+    "            \"ID\": 2,\n"
+    "            \"PLAN_NODE_TYPE\": \"ORDERBY\",\n"
+    "            \"SORT_COLUMNS\": [\n"
+    "                {\n"
+    "                    \"SORT_DIRECTION\": \"ASC\",\n"
+    "                    \"SORT_EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 0,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"SORT_DIRECTION\": \"ASC\",\n"
+    "                    \"SORT_EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 1,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"SORT_DIRECTION\": \"ASC\",\n"
+    "                    \"SORT_EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 2,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                }\n"
+    "            ]\n"
+    "        },\n"
+    "        {\n"
+    "            \"ID\": 1,\n"
+    "            \"PLAN_NODE_TYPE\": \"SEQSCAN\",\n"
+    "            \"TARGET_TABLE_ALIAS\": \"AAA\",\n"
+    "            \"TARGET_TABLE_NAME\": \"AAA\"\n"
+    "        }\n"
+    "    ]\n"
+    "}\n",
+    //  Plan for this query:
+    //      select SUM(C), MIN(C), RANK() OVER ( PARTITION BY A ORDER BY B DESC
+    //                 RANGE BETWEEN 10 PRECEDING AND CURRENT ROW ), A, B, C from AAA;
+    "{\n"
+    "    \"EXECUTE_LIST\": [\n"
+    "        1,\n"
+    "        2,\n"
+    "        3,\n"
+    "        4\n"
+    "    ],\n"
+    "    \"PLAN_NODES\": [\n"
+    "        {\n"
+    "            \"CHILDREN_IDS\": [\n"
+    "                3\n"
+    "            ],\n"
+    "            \"ID\": 4,\n"
+    "            \"PLAN_NODE_TYPE\": \"SEND\"\n"
+    "        },\n"
+    "        {\n"
+    "            \"AGGREGATE_COLUMNS\": [\n"
+    "                {\n"
+    "                    \"AGGREGATE_DISTINCT\": 0,\n"
+    "                    \"AGGREGATE_OUTPUT_COLUMN\": 0,\n"
+    "                    \"AGGREGATE_TYPE\": \"AGGREGATE_SUM\",\n"
+    "                    \"AGGREGATE_EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 2,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"AGGREGATE_DISTINCT\": 0,\n"
+    "                    \"AGGREGATE_OUTPUT_COLUMN\": 1,\n"
+    "                    \"AGGREGATE_TYPE\": \"AGGREGATE_MIN\",\n"
+    "                    \"AGGREGATE_EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 2,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"AGGREGATE_DISTINCT\": 0,\n"
+    "                    \"AGGREGATE_OUTPUT_COLUMN\": 2,\n"
+    "                    \"AGGREGATE_TYPE\": \"AGGREGATE_WINDOWED_RANK\"\n"
+    "                }\n"
+    "            ],\n"
+    "            \"CHILDREN_IDS\": [\n"
+    "                2\n"
+    "            ],\n"
+    "            \"GROUPBY_EXPRESSIONS\": [\n"
+    "                {\n"
+    "                    \"COLUMN_IDX\": 0,\n"
+    "                    \"TYPE\": 32,\n"
+    "                    \"VALUE_TYPE\": 5\n"
+    "                }\n"
+    "            ],\n"
+    "            \"ID\": 3,\n"
+    "            \"OUTPUT_SCHEMA\": [\n"
+    "                {\n"
+    "                    \"COLUMN_NAME\": \"W0\",\n"
+    "                    \"EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 0,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"COLUMN_NAME\": \"W1\",\n"
+    "                    \"EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 1,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"COLUMN_NAME\": \"W2\",\n"
+    "                    \"EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 2,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"COLUMN_NAME\": \"A\",\n"
+    "                    \"EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 0,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"COLUMN_NAME\": \"B\",\n"
+    "                    \"EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 1,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"COLUMN_NAME\": \"C\",\n"
+    "                    \"EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 2,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                }\n"
+    "            ],\n"
+    "            \"PLAN_NODE_TYPE\": \"PARTITIONBY\",\n"
+    "            \"SORT_COLUMNS\": [\n"
+    "                {\n"
+    "                    \"SORT_DIRECTION\": \"DESC\",\n"
+    "                    \"SORT_EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 1,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                }\n"
+    "            ],\n"
+    "            \"WINDOW_FRAME\": {\n"
+    "                \"FRAME_UNIT\": \"RANGE\",\n"
+    "                \"FRAME_START\": {\n"
+    "                    \"BOUND_TYPE\": \"PRECEDING\",\n"
+    "                    \"BOUND_OFFSET\": 10\n"
+    "                },\n"
+    "                \"FRAME_END\": {\n"
+    "                    \"BOUND_TYPE\": \"CURRENT_ROW\"\n"
+    "                }\n"
+    "            }\n"
+    "        },\n"
+    "        {\n"
+    "            \"CHILDREN_IDS\": [\n"
+    "                1\n"
+    "            ],\n"
+    "            \"ID\": 2,\n"
+    "            \"PLAN_NODE_TYPE\": \"ORDERBY\",\n"
+    "            \"SORT_COLUMNS\": [\n"
+    "                {\n"
+    "                    \"SORT_DIRECTION\": \"ASC\",\n"
+    "                    \"SORT_EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 0,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"SORT_DIRECTION\": \"DESC\",\n"
+    "                    \"SORT_EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 1,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                },\n"
+    "                {\n"
+    "                    \"SORT_DIRECTION\": \"ASC\",\n"
+    "                    \"SORT_EXPRESSION\": {\n"
+    "                        \"COLUMN_IDX\": 2,\n"
+    "                        \"TYPE\": 32,\n"
+    "                        \"VALUE_TYPE\": 5\n"
+    "                    }\n"
+    "                }\n"
+    "            ]\n"
+    "        },\n"
+    "        {\n"
+    "            \"ID\": 1,\n"
+    "            \"PLAN_NODE_TYPE\": \"SEQSCAN\",\n"
+    "            \"TARGET_TABLE_ALIAS\": \"AAA\",\n"
+    "            \"TARGET_TABLE_NAME\": \"AAA\"\n"
+    "        }\n"
+    "    ]\n"
+    "}\n",
     (const char *)0
 };
 
@@ -667,6 +1203,82 @@ TEST_F(PartitionByExecutorTest, testOrderedPartitionBy) {
     validateResult((int32_t *)output, NUM_ROWS, NUM_COLS);
 }
 
+TEST_F(PartitionByExecutorTest, testRowsFrame) {
+    const int NUM_ROWS = 15;
+    const int NUM_COLS =  7;
+
+    int32_t output[NUM_ROWS][NUM_COLS] = {
+            { 203, 101, 102, 2,  1,  10,  101},
+            { 404, 101, 201, 3,  1,  10,  102},
+            { 505, 102, 202, 3,  1,  20,  201},
+            { 704, 201, 301, 3,  1,  20,  202},
+            { 503, 202, 301, 2,  1,  30,  301},
+            { 203, 101, 102, 2,  2,  10,  101},
+            { 404, 101, 201, 3,  2,  10,  102},
+            { 505, 102, 202, 3,  2,  20,  201},
+            { 704, 201, 301, 3,  2,  20,  202},
+            { 503, 202, 301, 2,  2,  30,  301},
+            { 203, 101, 102, 2,  3,  10,  101},
+            { 404, 101, 201, 3,  3,  10,  102},
+            { 505, 102, 202, 3,  3,  20,  201},
+            { 704, 201, 301, 3,  3,  20,  202},
+            { 503, 202, 301, 2,  3,  30,  301}
+    };
+    executeFragment(100, plan_strings[2]);
+    validateResult((int32_t *)output, NUM_ROWS, NUM_COLS);
+}
+
+TEST_F(PartitionByExecutorTest, testDefaultFrame) {
+    const int NUM_ROWS = 15;
+    const int NUM_COLS =  7;
+
+    // Without a frame, each row's peers are part of its running totals.
+    int32_t output[NUM_ROWS][NUM_COLS] = {
+            { 203, 2, 101, 1,  1,  10,  101},
+            { 203, 2, 101, 1,  1,  10,  102},
+            { 606, 4, 151, 2,  1,  20,  201},
+            { 606, 4, 151, 2,  1,  20,  202},
+            { 907, 5, 181, 3,  1,  30,  301},
+            { 203, 2, 101, 1,  2,  10,  101},
+            { 203, 2, 101, 1,  2,  10,  102},
+            { 606, 4, 151, 2,  2,  20,  201},
+            { 606, 4, 151, 2,  2,  20,  202},
+            { 907, 5, 181, 3,  2,  30,  301},
+            { 203, 2, 101, 1,  3,  10,  101},
+            { 203, 2, 101, 1,  3,  10,  102},
+            { 606, 4, 151, 2,  3,  20,  201},
+            { 606, 4, 151, 2,  3,  20,  202},
+            { 907, 5, 181, 3,  3,  30,  301}
+    };
+    executeFragment(100, plan_strings[3]);
+    validateResult((int32_t *)output, NUM_ROWS, NUM_COLS);
+}
+
+TEST_F(PartitionByExecutorTest, testDescendingRangeFrame) {
+    const int NUM_ROWS = 15;
+    const int NUM_COLS =  6;
+
+    int32_t output[NUM_ROWS][NUM_COLS] = {
+            { 301, 301, 1,  1,  30,  301},
+            { 704, 201, 2,  1,  20,  201},
+            { 704, 201, 2,  1,  20,  202},
+            { 606, 101, 4,  1,  10,  101},
+            { 606, 101, 4,  1,  10,  102},
+            { 301, 301, 1,  2,  30,  301},
+            { 704, 201, 2,  2,  20,  201},
+            { 704, 201, 2,  2,  20,  202},
+            { 606, 101, 4,  2,  10,  101},
+            { 606, 101, 4,  2,  10,  102},
+            { 301, 301, 1,  3,  30,  301},
+            { 704, 201, 2,  3,  20,  201},
+            { 704, 201, 2,  3,  20,  202},
+            { 606, 101, 4,  3,  10,  101},
+            { 606, 101, 4,  3,  10,  102}
+    };
+    executeFragment(100, plan_strings[4]);
+    validateResult((int32_t *)output, NUM_ROWS, NUM_COLS);
+}
+
 int main() {
      return TestSuite::globalInstance()->runAll();
 }
@@ -123,6 +123,53 @@ TEST_F(CompactingHashIndexTest, ENG1193) {
     delete tuple4;
 }
 
+TEST_F(CompactingHashIndexTest, PrefetchKeyLeavesLookupsUnchanged) {
+    vector<int> columnIndices(1, 0);
+    vector<ValueType> columnTypes(1, VALUE_TYPE_BIGINT);
+    vector<int32_t> columnLengths(1, NValue::getTupleStorageSize(VALUE_TYPE_BIGINT));
+    vector<bool> columnAllowNull(1, false);
+    TupleSchema *schema = TupleSchema::createTupleSchemaForTest(columnTypes,
+                                                                columnLengths,
+                                                                columnAllowNull);
+
+    TableIndexScheme treeScheme("tree_index", BALANCED_TREE_INDEX,
+                                columnIndices, TableIndex::simplyIndexColumns(),
+                                true, false, schema);
+    TableIndex *treeIndex = TableIndexFactory::getInstance(treeScheme);
+    EXPECT_FALSE(treeIndex->canPrefetchKeys());
+    delete treeIndex;
+
+    TableIndexScheme scheme("test_index", HASH_TABLE_INDEX,
+                            columnIndices, TableIndex::simplyIndexColumns(),
+                            true, false, schema);
+    TableIndex *index = TableIndexFactory::getInstance(scheme);
+    ASSERT_TRUE(index->canPrefetchKeys());
+
+    vector<TableTuple*> tuples;
+    for (int ii = 0; ii < 100; ++ii) {
+        tuples.push_back(newTuple(schema, 0, ii * 2));
+        index->addEntry(tuples.back(), NULL);
+    }
+
+    TableTuple *searchKey = newTuple(index->getKeySchema(), 0, 0);
+    IndexCursor cursor(index->getTupleSchema());
+    for (int ii = 0; ii < 200; ++ii) {
+        searchKey->setNValue(0, ValueFactory::getBigIntValue(ii));
+        index->prefetchKey(searchKey);
+        EXPECT_EQ(ii % 2 == 0, index->moveToKey(searchKey, cursor));
+    }
+    EXPECT_EQ(100, index->getSize());
+
+    delete index;
+    delete[] searchKey->address();
+    delete searchKey;
+    for (int ii = 0; ii < tuples.size(); ++ii) {
+        delete[] tuples[ii]->address();
+        delete tuples[ii];
+    }
+    TupleSchema::freeTupleSchema(schema);
+}
+
 int main()
 {
     return TestSuite::globalInstance()->runAll();
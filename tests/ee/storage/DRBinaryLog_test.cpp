@@ -925,6 +925,31 @@ TEST_F(DRBinaryLogTest, PartitionedTableRollbacks) {
     EXPECT_EQ(0, committed.seqNum);
 }
 
+TEST_F(DRBinaryLogTest, CompressedBuffers) {
+    m_drStream.setBlockCompression(true);
+    ASSERT_FALSE(flush(98));
+
+    // similar rows in one buffer so that it is worth compressing
+    beginTxn(m_engine, 99, 99, 98, 70);
+    std::vector<TableTuple> tuples;
+    for (int i = 0; i < 50; i++) {
+        tuples.push_back(insertTuple(m_table, prepareTempTuple(m_table, 42, 55555 + i, "349508345.34583", "a thing", "this is a rather long string of text that is used to cause nvalue to use outline storage for the underlying data. It should be longer than 64 bytes.", 5433)));
+    }
+    endTxn(m_engine, true);
+
+    beginTxn(m_engine, 100, 100, 99, 71);
+    deleteTuple(m_table, tuples[0]);
+    endTxn(m_engine, true);
+
+    flushAndApply(100);
+
+    EXPECT_EQ(49, m_tableReplica->activeTupleCount());
+    for (int i = 1; i < 50; i++) {
+        TableTuple tuple = m_tableReplica->lookupTupleForDR(tuples[i]);
+        ASSERT_FALSE(tuple.isNullTuple());
+    }
+}
+
 TEST_F(DRBinaryLogTest, ReplicatedTableWrites) {
     // write to only the replicated table
     beginTxn(m_engine, 109, 99, 98, 70);
@@ -1292,6 +1317,70 @@ TEST_F(DRBinaryLogTest, DetectInsertUniqueConstraintViolation) {
     EXPECT_EQ(2, exportStream->receivedTuples.size());
 }
 
+/*
+ * An insert and a delete of the same row in one transaction leave the
+ * replica as it was, while the rest of the transaction is applied.
+ */
+TEST_F(DRBinaryLogTest, InsertThenDeleteInOneTxn) {
+    createUniqueIndex(m_table, 0, true);
+    createUniqueIndex(m_tableReplica, 0, true);
+
+    beginTxn(m_engine, 99, 99, 98, 70);
+    TableTuple first_tuple = insertTuple(m_table, prepareTempTuple(m_table, 42, 55555, "349508345.34583", "a thing", "this is a rather long string of text that is used to cause nvalue to use outline storage for the underlying data. It should be longer than 64 bytes.", 5433));
+    TableTuple existedTuple(m_table->schema());
+    boost::shared_array<char> existedData;
+    existedData = deepCopy(first_tuple, existedTuple, existedData);
+    StackCleaner existingTupleCleaner(existedTuple);
+    deleteTuple(m_table, first_tuple);
+    TableTuple second_tuple = insertTuple(m_table, prepareTempTuple(m_table, 24, 2321, "23455.5554", "and another", "this is starting to get even sillier", 2222));
+    endTxn(m_engine, true);
+
+    flushAndApply(99);
+
+    EXPECT_EQ(1, m_tableReplica->activeTupleCount());
+    EXPECT_EQ(1, m_tableReplica->primaryKeyIndex()->getSize());
+    TableTuple tuple = m_tableReplica->lookupTupleForDR(existedTuple);
+    ASSERT_TRUE(tuple.isNullTuple());
+    tuple = m_tableReplica->lookupTupleForDR(second_tuple);
+    ASSERT_FALSE(tuple.isNullTuple());
+}
+
+/*
+ * An insert that is deleted again in the same transaction must still
+ * report its unique constraint violation rather than cancel out.
+ */
+TEST_F(DRBinaryLogTest, DetectInsertUniqueConstraintViolationBeforeDelete) {
+    enableActiveActive();
+    createUniqueIndex(m_table, 0, true);
+    createUniqueIndex(m_tableReplica, 0, true);
+    ASSERT_FALSE(flush(99));
+
+    // write transactions on replica
+    beginTxn(m_engineReplica, 100, 100, 99, 71);
+    insertTuple(m_tableReplica, prepareTempTuple(m_tableReplica, 42, 34523,
+                "7565464.2342", "yes", "no no no, writing more words to make it outline?", 1234));
+    endTxn(m_engineReplica, true);
+    flushButDontApply(100);
+
+    // write transactions on master
+    beginTxn(m_engine, 101, 101, 100, 72);
+    TableTuple newTuple = insertTuple(m_table, prepareTempTuple(m_table, 42, 34523,
+            "92384598.2342", "what", "really, why am I writing anything in these?", 3455));
+    deleteTuple(m_table, newTuple);
+    endTxn(m_engine, true);
+    flushAndApply(101);
+
+    // the rejected insert leaves the local row in place, so the delete
+    // then reports a mismatch on top of the insert's constraint violation
+    EXPECT_EQ(m_topend.actionType, DR_RECORD_DELETE);
+    EXPECT_EQ(m_topend.deleteConflictType, CONFLICT_EXPECTED_ROW_MISMATCH);
+    EXPECT_EQ(1, m_tableReplica->activeTupleCount());
+
+    // check export: two rows for the insert conflict, three for the delete
+    MockExportTupleStream *exportStream = reinterpret_cast<MockExportTupleStream*>(m_engineReplica->getExportTupleStream());
+    EXPECT_EQ(5, exportStream->receivedTuples.size());
+}
+
 /*
  * Conflict detection test case - Delete Missing Tuple
  *
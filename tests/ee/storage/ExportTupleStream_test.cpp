@@ -498,6 +498,65 @@ TEST_F(ExportTupleStreamTest, RollbackWholeBuffer)
     EXPECT_EQ(results->offset(), (MAGIC_TUPLE_SIZE * 10));
 }
 
+/**
+ * A null column takes no data bytes and sets its bit in the null mask;
+ * the non-null columns around it are still written in order.
+ */
+TEST_F(ExportTupleStreamTest, NullColumnInFixedWidthRun)
+{
+    for (int col = 0; col < COLUMN_COUNT; col++) {
+        m_tuple->setNValue(col, ValueFactory::getIntegerValue(col + 100));
+    }
+    m_tuple->setNValue(2, NValue::getNullValue(VALUE_TYPE_INTEGER));
+    m_wrapper->appendTuple(1, 2, 1, 1, 1, *m_tuple, ExportTupleStream::INSERT);
+    m_wrapper->periodicFlush(-1, 2);
+
+    ASSERT_TRUE(m_topend.receivedExportBuffer);
+    boost::shared_ptr<StreamBlock> results = m_topend.blocks.front();
+    EXPECT_EQ(results->offset(), MAGIC_TUPLE_SIZE - sizeof (int32_t));
+
+    const char *row = results->rawPtr() + results->headerSize();
+    // metadata columns occupy bits 0-5, so column 2 is bit 8
+    EXPECT_EQ(static_cast<uint8_t>(row[4]), 0);
+    EXPECT_EQ(static_cast<uint8_t>(row[5]), 0x80);
+    const char *data = row + 6 + (sizeof (int64_t) * 5) + 1;
+    int32_t expected[] = { 100, 101, 103, 104 };
+    EXPECT_EQ(::memcmp(data, expected, sizeof (expected)), 0);
+}
+
+/**
+ * appendTuples produces the same bytes as one appendTuple per row
+ * with consecutive sequence numbers.
+ */
+TEST_F(ExportTupleStreamTest, AppendTuplesMatchesAppendTuple)
+{
+    const int tupleCount = 3;
+    char tupleMemory[tupleCount][(COLUMN_COUNT + 1) * 8];
+    std::vector<TableTuple> tuples;
+    for (int i = 0; i < tupleCount; i++) {
+        ::memset(tupleMemory[i], 0, sizeof (tupleMemory[i]));
+        tuples.push_back(TableTuple(tupleMemory[i], m_schema));
+        for (int col = 0; col < COLUMN_COUNT; col++) {
+            tuples[i].setNValue(col, ValueFactory::getIntegerValue(rand()));
+        }
+    }
+
+    for (int i = 0; i < tupleCount; i++) {
+        m_wrapper->appendTuple(1, 2, 10 + i, 1, 1, tuples[i], ExportTupleStream::INSERT);
+    }
+    size_t uso = m_wrapper->appendTuples(1, 2, 10, 1, 1, &tuples[0], tupleCount,
+                                         ExportTupleStream::INSERT);
+    EXPECT_EQ(uso, MAGIC_TUPLE_SIZE * tupleCount);
+    m_wrapper->periodicFlush(-1, 2);
+
+    ASSERT_TRUE(m_topend.receivedExportBuffer);
+    boost::shared_ptr<StreamBlock> results = m_topend.blocks.front();
+    EXPECT_EQ(results->offset(), MAGIC_TUPLE_SIZE * tupleCount * 2);
+    const char *data = results->rawPtr() + results->headerSize();
+    EXPECT_EQ(::memcmp(data, data + MAGIC_TUPLE_SIZE * tupleCount,
+                       MAGIC_TUPLE_SIZE * tupleCount), 0);
+}
+
 int main() {
     return TestSuite::globalInstance()->runAll();
 }
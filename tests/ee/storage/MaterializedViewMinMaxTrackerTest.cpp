@@ -0,0 +1,194 @@
+/* This file is part of VoltDB.
+ * Copyright (C) 2008-2016 VoltDB Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "harness.h"
+
+#include "common/TupleSchema.h"
+#include "common/UndoQuantum.h"
+#include "common/ValueFactory.hpp"
+#include "common/ValuePeeker.hpp"
+#include "common/executorcontext.hpp"
+#include "execution/VoltDBEngine.h"
+#include "storage/MaterializedViewMinMaxTracker.h"
+#include "storage/persistenttable.h"
+#include "storage/tablefactory.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace voltdb;
+
+class MaterializedViewMinMaxTrackerTest : public Test {
+public:
+    MaterializedViewMinMaxTrackerTest() {
+        m_engine = new VoltDBEngine();
+        int partitionCount = 1;
+        m_engine->initialize(1, 1, 0, 0, "", 0, 1024, DEFAULT_TEMP_TABLE_MEMORY, false);
+        m_engine->updateHashinator(HASHINATOR_LEGACY, (char*)&partitionCount, NULL, 0);
+
+        vector<ValueType> types(1, VALUE_TYPE_BIGINT);
+        vector<int32_t> sizes(1, NValue::getTupleStorageSize(VALUE_TYPE_BIGINT));
+        vector<bool> allowNull(1, true);
+        vector<string> names(1, "C0");
+        TupleSchema *schema = TupleSchema::createTupleSchemaForTest(types, sizes, allowNull);
+        m_table = dynamic_cast<PersistentTable*>(
+            TableFactory::getPersistentTable(0, "VIEW", schema, names, m_signature));
+        m_table->incrementRefcount();
+    }
+
+    ~MaterializedViewMinMaxTrackerTest() {
+        m_table->decrementRefcount();
+        delete m_engine;
+    }
+
+    static vector<NValue> groupKey(const string &group) {
+        return vector<NValue>(1, ValueFactory::getTempStringValue(group));
+    }
+
+    // One integer column and one string column are tracked.
+    static vector<NValue> values(int64_t number, const string &text) {
+        vector<NValue> result;
+        result.push_back(ValueFactory::getBigIntValue(number));
+        result.push_back(ValueFactory::getTempStringValue(text));
+        return result;
+    }
+
+    static int64_t extremeNumber(const MaterializedViewMinMaxTracker &tracker,
+                                 const string &group, bool forMin) {
+        NValue value;
+        if ( ! tracker.findExtremeValue(groupKey(group), 0, forMin, value)) {
+            return -1;
+        }
+        return ValuePeeker::peekBigInt(value);
+    }
+
+    static string extremeText(const MaterializedViewMinMaxTracker &tracker,
+                              const string &group, bool forMin) {
+        NValue value;
+        if ( ! tracker.findExtremeValue(groupKey(group), 1, forMin, value)) {
+            return "";
+        }
+        int32_t length;
+        const char *text = ValuePeeker::peekObject_withoutNull(value, &length);
+        return string(text, length);
+    }
+
+protected:
+    VoltDBEngine *m_engine;
+    PersistentTable *m_table;
+    char m_signature[20];
+};
+
+TEST_F(MaterializedViewMinMaxTrackerTest, AddAndRemove) {
+    MaterializedViewMinMaxTracker tracker(2, m_table);
+    tracker.addValues(groupKey("a"), values(5, "mmm"));
+    tracker.addValues(groupKey("a"), values(2, "zzz"));
+    tracker.addValues(groupKey("a"), values(2, "aaa"));
+    tracker.addValues(groupKey("a"), values(9, "mmm"));
+    tracker.addValues(groupKey("b"), values(100, "bbb"));
+    ASSERT_EQ(2, tracker.groupCount());
+
+    EXPECT_EQ(2, extremeNumber(tracker, "a", true));
+    EXPECT_EQ(9, extremeNumber(tracker, "a", false));
+    EXPECT_EQ("aaa", extremeText(tracker, "a", true));
+    EXPECT_EQ("zzz", extremeText(tracker, "a", false));
+
+    // The duplicate 2 keeps the minimum in place.
+    tracker.removeValues(groupKey("a"), values(2, "zzz"));
+    EXPECT_EQ(2, extremeNumber(tracker, "a", true));
+    EXPECT_EQ("mmm", extremeText(tracker, "a", false));
+    tracker.removeValues(groupKey("a"), values(2, "aaa"));
+    EXPECT_EQ(5, extremeNumber(tracker, "a", true));
+    EXPECT_EQ("mmm", extremeText(tracker, "a", true));
+
+    // NULL inputs are not counted.
+    vector<NValue> nulls;
+    nulls.push_back(NValue::getNullValue(VALUE_TYPE_BIGINT));
+    nulls.push_back(NValue::getNullValue(VALUE_TYPE_VARCHAR));
+    tracker.addValues(groupKey("b"), nulls);
+    tracker.removeValues(groupKey("b"), values(100, "bbb"));
+    EXPECT_EQ(-1, extremeNumber(tracker, "b", true));
+    EXPECT_EQ("", extremeText(tracker, "b", false));
+    EXPECT_EQ(1, tracker.groupCount());
+
+    tracker.removeValues(groupKey("a"), values(5, "mmm"));
+    tracker.removeValues(groupKey("a"), values(9, "mmm"));
+    EXPECT_EQ(0, tracker.groupCount());
+    EXPECT_EQ(0, tracker.memorySize());
+}
+
+TEST_F(MaterializedViewMinMaxTrackerTest, MemoryIsChargedToTheViewTable) {
+    int64_t blockMemory = m_table->allocatedTupleMemory();
+    {
+        MaterializedViewMinMaxTracker tracker(2, m_table);
+        for (int ii = 0; ii < 100; ++ii) {
+            tracker.addValues(groupKey("group"), values(ii, string(ii + 1, 'x')));
+        }
+        ASSERT_TRUE(tracker.memorySize() > 100 * 100 / 2);
+        EXPECT_EQ(tracker.memorySize(), m_table->auxiliaryMemorySize());
+        EXPECT_EQ(blockMemory + tracker.memorySize(), m_table->allocatedTupleMemory());
+
+        tracker.setTargetTable(NULL);
+        EXPECT_EQ(0, m_table->auxiliaryMemorySize());
+        tracker.setTargetTable(m_table);
+        EXPECT_EQ(tracker.memorySize(), m_table->auxiliaryMemorySize());
+    }
+    EXPECT_EQ(0, m_table->auxiliaryMemorySize());
+    EXPECT_EQ(blockMemory, m_table->allocatedTupleMemory());
+}
+
+TEST_F(MaterializedViewMinMaxTrackerTest, UndoRestoresValues) {
+    boost::shared_ptr<MaterializedViewMinMaxTracker> tracker(
+        new MaterializedViewMinMaxTracker(2, m_table));
+    tracker->addValues(groupKey("a"), values(3, "ccc"));
+    tracker->addValues(groupKey("a"), values(7, "ggg"));
+    int64_t memorySize = tracker->memorySize();
+
+    m_engine->setUndoToken(100);
+    m_engine->updateExecutorContextUndoQuantumForTest();
+    UndoQuantum *uq = ExecutorContext::currentUndoQuantum();
+    ASSERT_TRUE(uq != NULL);
+
+    // Take away the maximum and add a new minimum, then roll back both.
+    tracker->removeValues(groupKey("a"), values(7, "ggg"));
+    uq->registerUndoAction(new (*uq) MaterializedViewMinMaxUndoAction(tracker, groupKey("a"),
+                                                                      values(7, "ggg"), false));
+    tracker->addValues(groupKey("a"), values(1, "aaa"));
+    uq->registerUndoAction(new (*uq) MaterializedViewMinMaxUndoAction(tracker, groupKey("a"),
+                                                                      values(1, "aaa"), true));
+    EXPECT_EQ(1, extremeNumber(*tracker, "a", true));
+    EXPECT_EQ("ccc", extremeText(*tracker, "a", false));
+
+    m_engine->undoUndoToken(100);
+    EXPECT_EQ(3, extremeNumber(*tracker, "a", true));
+    EXPECT_EQ(7, extremeNumber(*tracker, "a", false));
+    EXPECT_EQ("ggg", extremeText(*tracker, "a", false));
+    EXPECT_EQ(memorySize, tracker->memorySize());
+}
+
+int main() {
+    return TestSuite::globalInstance()->runAll();
+}
@@ -288,6 +288,45 @@ TEST_F(PersistentTableLogTest, LoadTableThenReleaseTest) {
     ASSERT_TRUE(m_table->activeTupleCount() == (int64_t)1000);
 }
 
+TEST_F(PersistentTableLogTest, LoadTableReportsDuplicatesAfterIndexBuildTest) {
+    initTable();
+    tableutil::addRandomTuples(m_table, 1000);
+
+    CopySerializeOutput serialize_out;
+    m_table->serializeTo(serialize_out);
+
+    m_engine->setUndoToken(INT64_MIN + 2);
+    m_engine->updateExecutorContextUndoQuantumForTest();
+    m_table->deleteAllTuples(true);
+    m_engine->releaseUndoToken(INT64_MIN + 2);
+
+    delete m_table;
+
+    initTable();
+
+    m_engine->setUndoToken(INT64_MIN + 3);
+    m_engine->updateExecutorContextUndoQuantumForTest();
+
+    // The first load indexes every tuple; the second load of the same rows
+    // must report each of them as a unique constraint violation.
+    ReferenceSerializeInputBE first_in(serialize_out.data() + sizeof(int32_t), serialize_out.size() - sizeof(int32_t));
+    m_table->loadTuplesFrom(first_in, NULL, NULL);
+    ASSERT_EQ(1000, m_table->activeTupleCount());
+    ASSERT_EQ(1000, m_table->primaryKeyIndex()->getSize());
+
+    char violations[1024 * 1024];
+    ReferenceSerializeOutput violation_out(violations, sizeof(violations));
+    ReferenceSerializeInputBE second_in(serialize_out.data() + sizeof(int32_t), serialize_out.size() - sizeof(int32_t));
+    m_table->loadTuplesFrom(second_in, NULL, &violation_out);
+    ASSERT_EQ(1000, m_table->activeTupleCount());
+    ASSERT_EQ(1000, m_table->primaryKeyIndex()->getSize());
+    ASSERT_TRUE(violation_out.position() > sizeof(int32_t));
+
+    m_engine->undoUndoToken(INT64_MIN + 3);
+    ASSERT_EQ(0, m_table->activeTupleCount());
+    ASSERT_EQ(0, m_table->primaryKeyIndex()->getSize());
+}
+
 TEST_F(PersistentTableLogTest, InsertUpdateThenUndoOneTest) {
     initTable();
     tableutil::addRandomTuples(m_table, 1);
@@ -343,6 +382,46 @@ TEST_F(PersistentTableLogTest, InsertUpdateThenUndoOneTest) {
     oldStringValue.free();
 }
 
+TEST_F(PersistentTableLogTest, UpdateNonKeyColumnsThenUndoRestoresBytesTest) {
+    initTable();
+    tableutil::addRandomTuples(m_table, 1);
+    voltdb::TableTuple tuple(m_tableSchema);
+    tableutil::getRandomTuple(m_table, tuple);
+
+    // The exact stored bytes, including the pointers to the uninlined strings.
+    const int tupleLength = tuple.tupleLength();
+    std::vector<char> storedBytes(tuple.address(), tuple.address() + tupleLength);
+
+    voltdb::TableTuple tupleCopy(m_tableSchema);
+    tupleCopy.move(new char[tupleCopy.tupleLength()]);
+    tupleCopy.copyForPersistentInsert(tuple);
+
+    m_engine->setUndoToken(INT64_MIN + 2);
+    m_engine->updateExecutorContextUndoQuantumForTest();
+
+    // None of these columns is in the primary key, so no index is updated
+    // and only the changed bytes are kept for undo.
+    tupleCopy.setNValue(2, ValueFactory::getIntegerValue(12345));
+    tupleCopy.setNValue(5, ValueFactory::getDoubleValue(2.5));
+    NValue oldStringValue = tupleCopy.getNValue(8);
+    // The uninlined copy now belongs to tupleCopy and is freed with it.
+    tupleCopy.setNValue(8, ValueFactory::getStringValue(std::string(400, 'z')));
+    m_table->updateTuple(tuple, tupleCopy);
+    ASSERT_EQ(0, tuple.getNValue(2).compare(ValueFactory::getIntegerValue(12345)));
+
+    m_engine->undoUndoToken(INT64_MIN + 2);
+
+    TableTuple restored = m_table->lookupTupleForUndo(tupleCopy);
+    ASSERT_FALSE(restored.isNullTuple());
+    ASSERT_EQ(tuple.address(), restored.address());
+    EXPECT_EQ(0, ::memcmp(&storedBytes[0], restored.address(), tupleLength));
+    EXPECT_EQ(1, m_table->activeTupleCount());
+
+    tupleCopy.freeObjectColumns();
+    delete [] tupleCopy.address();
+    oldStringValue.free();
+}
+
 TEST_F(PersistentTableLogTest, InsertThenUndoInsertsOneTest) {
     initTable();
     tableutil::addRandomTuples(m_table, 10);
@@ -32,6 +32,7 @@
 #include "common/tabletuple.h"
 #include "common/types.h"
 #include "common/TupleSchemaBuilder.h"
+#include "common/ValuePeeker.hpp"
 #include "common/ValueFactory.hpp"
 #include "execution/VoltDBEngine.h"
 #include "storage/table.h"
@@ -50,7 +51,9 @@ using voltdb::TupleSchemaBuilder;
 using voltdb::VALUE_TYPE_BIGINT;
 using voltdb::VALUE_TYPE_VARCHAR;
 using voltdb::ValueFactory;
+using voltdb::ValuePeeker;
 using voltdb::VoltDBEngine;
+using voltdb::ZoneMapFilter;
 using voltdb::tableutil;
 
 class PersistentTableTest : public Test {
@@ -312,6 +315,132 @@ TEST_F(PersistentTableTest, TruncateTableTest) {
     ASSERT_EQ(1, table->allocatedBlockCount());
 }
 
+TEST_F(PersistentTableTest, RelaxSchemaInPlace) {
+    VoltDBEngine* engine = getEngine();
+    engine->loadCatalog(0, catalogPayload());
+    PersistentTable *table = dynamic_cast<PersistentTable*>(engine->getTable("T"));
+    ASSERT_NE(NULL, table);
+
+    voltdb::StandAloneTupleStorage storage(table->schema());
+    TableTuple &srcTuple = const_cast<TableTuple&>(storage.tuple());
+    beginWork();
+    srcTuple.setNValue(0, ValueFactory::getBigIntValue(1));
+    srcTuple.setNValue(1, ValueFactory::getTempStringValue(std::string(200, 'a')));
+    table->insertTuple(srcTuple);
+    commit();
+
+    // Widening the out-of-line DATA column keeps the same table and tuples.
+    engine->updateCatalog(1, "set /clusters#cluster/databases#database/tables#T/columns#DATA size 512\n");
+    ASSERT_EQ(table, engine->getTable("T"));
+    ASSERT_EQ(512, table->schema()->getColumnInfo(1)->length);
+    ASSERT_EQ(1, table->activeTupleCount());
+
+    // The stand-alone tuple keeps its own copy of the old schema.
+    storage.init(table->schema());
+    beginWork();
+    srcTuple.setNValue(0, ValueFactory::getBigIntValue(2));
+    srcTuple.setNValue(1, ValueFactory::getTempStringValue(std::string(400, 'b')));
+    table->insertTuple(srcTuple);
+    commit();
+
+    TableTuple tuple(table->schema());
+    TableIterator iterator = table->iterator();
+    ASSERT_TRUE(iterator.next(tuple));
+    EXPECT_EQ(0, tuple.getNValue(1).compare(
+                  ValueFactory::getTempStringValue(std::string(200, 'a'))));
+    ASSERT_TRUE(iterator.next(tuple));
+    EXPECT_EQ(0, tuple.getNValue(1).compare(
+                  ValueFactory::getTempStringValue(std::string(400, 'b'))));
+
+    // Letting the indexed PK column take nulls rebuilds the table.
+    engine->updateCatalog(2, "set /clusters#cluster/databases#database/tables#T/columns#PK nullable true\n");
+    PersistentTable *rebuilt = dynamic_cast<PersistentTable*>(engine->getTable("T"));
+    ASSERT_NE(NULL, rebuilt);
+    ASSERT_NE(table, rebuilt);
+    ASSERT_EQ(2, rebuilt->activeTupleCount());
+}
+
+// Scan the table with a zone map filter on the PK column, returning the
+// number of tuples with a PK in the range and setting the number visited.
+static int64_t scanZoneMapRange(PersistentTable *table, int64_t low, int64_t high, int64_t &visited) {
+    ZoneMapFilter filter;
+    filter.restrict(table->zoneMapSlot(0), low, high);
+    TableTuple tuple(table->schema());
+    TableIterator iterator = table->iterator();
+    iterator.setZoneMapFilter(&filter);
+    int64_t found = 0;
+    visited = 0;
+    while (iterator.next(tuple)) {
+        ++visited;
+        int64_t id = ValuePeeker::peekBigInt(tuple.getNValue(0));
+        if (id >= low && id <= high) {
+            ++found;
+        }
+    }
+    return found;
+}
+
+TEST_F(PersistentTableTest, ZoneMapsSkipBlocks) {
+    VoltDBEngine* engine = getEngine();
+    engine->loadCatalog(0, catalogPayload());
+    PersistentTable *table = dynamic_cast<PersistentTable*>(engine->getTable("T"));
+    ASSERT_NE(NULL, table);
+
+    // Ascending ids fill the blocks one after the other.
+    const int64_t tuplesPerBlock = table->getTuplesPerBlock();
+    const int64_t tupleCount = 3 * tuplesPerBlock;
+    voltdb::StandAloneTupleStorage storage(table->schema());
+    TableTuple &srcTuple = const_cast<TableTuple&>(storage.tuple());
+    srcTuple.setNValue(1, ValueFactory::getNullStringValue());
+    beginWork();
+    for (int64_t id = 0; id < tupleCount; ++id) {
+        srcTuple.setNValue(0, ValueFactory::getBigIntValue(id));
+        table->insertTuple(srcTuple);
+    }
+    commit();
+    ASSERT_EQ(3, table->allocatedBlockCount());
+
+    // Only integer and timestamp columns have zone maps.
+    EXPECT_EQ(-1, table->zoneMapSlot(1));
+    EXPECT_EQ(0, table->zoneMapSlot(0));
+    EXPECT_EQ(0, table->zoneMapSlot(0));
+    EXPECT_EQ(1, table->zoneMapColumnCount());
+
+    int64_t visited;
+    EXPECT_EQ(50, scanZoneMapRange(table, tupleCount - 100, tupleCount - 51, visited));
+    EXPECT_EQ(tuplesPerBlock, visited);
+    EXPECT_EQ(0, scanZoneMapRange(table, tupleCount, tupleCount + 100, visited));
+    EXPECT_EQ(0, visited);
+    EXPECT_EQ(tuplesPerBlock + 2,
+              scanZoneMapRange(table, tuplesPerBlock - 1, 2 * tuplesPerBlock, visited));
+    EXPECT_EQ(tupleCount, visited);
+
+    // Moving a tuple past the end widens the zone of its block.
+    TableTuple tuple(table->schema());
+    TableIterator iterator = table->iterator();
+    ASSERT_TRUE(iterator.next(tuple));
+    int64_t oldId = ValuePeeker::peekBigInt(tuple.getNValue(0));
+    beginWork();
+    srcTuple.setNValue(0, ValueFactory::getBigIntValue(tupleCount + 5));
+    table->updateTuple(tuple, srcTuple);
+    EXPECT_EQ(1, scanZoneMapRange(table, tupleCount + 5, tupleCount + 5, visited));
+    EXPECT_EQ(tuplesPerBlock, visited);
+
+    // Undoing it keeps the old value covered.
+    rollback();
+    EXPECT_EQ(0, scanZoneMapRange(table, tupleCount + 5, tupleCount + 5, visited));
+    EXPECT_EQ(1, scanZoneMapRange(table, oldId, oldId, visited));
+
+    // Deletes leave the zones as wide as they were.
+    beginWork();
+    tuple = table->lookupTupleByValues(tuple);
+    ASSERT_FALSE(tuple.isNullTuple());
+    table->deleteTuple(tuple, true);
+    commit();
+    EXPECT_EQ(0, scanZoneMapRange(table, oldId, oldId, visited));
+    EXPECT_EQ(tuplesPerBlock - 1, visited);
+}
+
 int main() {
     return TestSuite::globalInstance()->runAll();
 }
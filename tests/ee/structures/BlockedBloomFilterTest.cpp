@@ -0,0 +1,124 @@
+/* This file is part of VoltDB.
+ * Copyright (C) 2008-2016 VoltDB Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "structures/BlockedBloomFilter.h"
+
+#include "harness.h"
+
+#include <boost/functional/hash.hpp>
+
+using namespace voltdb;
+
+class BlockedBloomFilterTest : public Test
+{
+public:
+    BlockedBloomFilterTest()
+    {
+    }
+
+    ~BlockedBloomFilterTest()
+    {
+    }
+
+    // Hash keys the way the engine does, which leaves small integers as
+    // they are when combined into a zero seed.
+    static std::size_t keyHash(int64_t key)
+    {
+        std::size_t seed = 0;
+        boost::hash_combine(seed, key);
+        return seed;
+    }
+};
+
+TEST_F(BlockedBloomFilterTest, SizedForTheKeys)
+{
+    BlockedBloomFilter filter;
+    filter.reset(0);
+    EXPECT_EQ(1, filter.blockCount());
+    // 512 bits per block at 16 bits per key
+    filter.reset(32);
+    EXPECT_EQ(1, filter.blockCount());
+    filter.reset(33);
+    EXPECT_EQ(2, filter.blockCount());
+    filter.reset(100000);
+    EXPECT_EQ(4096, filter.blockCount());
+    filter.reset(1 << 30);
+    EXPECT_EQ(BlockedBloomFilter::MAX_BLOCKS, filter.blockCount());
+}
+
+TEST_F(BlockedBloomFilterTest, EmptyFilterHoldsNothing)
+{
+    BlockedBloomFilter filter;
+    filter.reset(1000);
+    for (int64_t key = 0; key < 1000; key++) {
+        EXPECT_FALSE(filter.mayContain(keyHash(key)));
+    }
+}
+
+TEST_F(BlockedBloomFilterTest, NoFalseNegatives)
+{
+    const int64_t keyCount = 100000;
+    BlockedBloomFilter filter;
+    filter.reset(keyCount);
+    for (int64_t key = 0; key < keyCount; key++) {
+        filter.insert(keyHash(key * 7));
+    }
+    for (int64_t key = 0; key < keyCount; key++) {
+        ASSERT_TRUE(filter.mayContain(keyHash(key * 7)));
+    }
+
+    // Refilling the filter drops the earlier keys.
+    filter.reset(keyCount);
+    filter.insert(keyHash(-1));
+    EXPECT_TRUE(filter.mayContain(keyHash(-1)));
+    int present = 0;
+    for (int64_t key = 0; key < keyCount; key++) {
+        if (filter.mayContain(keyHash(key * 7))) {
+            present++;
+        }
+    }
+    EXPECT_EQ(0, present);
+}
+
+TEST_F(BlockedBloomFilterTest, FewFalsePositives)
+{
+    const int64_t keyCount = 100000;
+    BlockedBloomFilter filter;
+    filter.reset(keyCount);
+    // Consecutive keys, as a dense primary key would give
+    for (int64_t key = 0; key < keyCount; key++) {
+        filter.insert(keyHash(key));
+    }
+    int falsePositives = 0;
+    for (int64_t key = keyCount; key < keyCount * 11; key++) {
+        if (filter.mayContain(keyHash(key))) {
+            falsePositives++;
+        }
+    }
+    // Under 1% of a million absent keys
+    EXPECT_TRUE(falsePositives < 10000);
+}
+
+int main() {
+    return TestSuite::globalInstance()->runAll();
+}
@@ -59,15 +59,24 @@ typedef int64_t fragmentId_t;
 class EngineTestTopend : public voltdb::DummyTopend {
     typedef std::map<fragmentId_t, std::string> fragmentMap;
     fragmentMap m_fragments;
+    int m_planFetchCount;
 public:
+    EngineTestTopend() : m_planFetchCount(0) { }
+
     static EngineTestTopend *newInstance() {
         return new EngineTestTopend();
     }
 
+    /** How many times the engine has had to ask for a plan. */
+    int planFetchCount() const {
+        return m_planFetchCount;
+    }
+
     void addPlan(fragmentId_t fragmentId, const std::string &planStr) {
         m_fragments[fragmentId] = planStr;
     }
     std::string planForFragmentId(fragmentId_t fragmentId) {
+        ++m_planFetchCount;
         fragmentMap::iterator it = m_fragments.find(fragmentId);
         if (it == m_fragments.end()) {
             return "";